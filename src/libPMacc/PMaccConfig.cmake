@@ -78,6 +78,21 @@ IF(PMACC_BLOCKING_KERNEL)
     LIST(APPEND _PMACC_COMPILE_DEFINITIONS_PUBLIC "PMACC_SYNC_KERNEL=1")
 ENDIF(PMACC_BLOCKING_KERNEL)
 
+OPTION(PMACC_CPU_SYNC_STREAM "CPU only: execute all kernels and copies blocking in the host thread instead of one worker thread per stream" OFF)
+IF(PMACC_CPU_SYNC_STREAM)
+    LIST(APPEND _PMACC_COMPILE_DEFINITIONS_PUBLIC "PMACC_CPU_SYNC_STREAM=1")
+ENDIF(PMACC_CPU_SYNC_STREAM)
+
+OPTION(PMACC_FRAME_POOL "CPU only: allocate particle frames from a lock-free per species frame pool instead of calling mallocMC for each frame" ON)
+IF(NOT PMACC_FRAME_POOL)
+    LIST(APPEND _PMACC_COMPILE_DEFINITIONS_PUBLIC "PMACC_FRAME_POOL=0")
+ENDIF(NOT PMACC_FRAME_POOL)
+
+OPTION(PMACC_KERNEL_ELEMENT_LAYER "CPU only: map the cells of a block to the alpaka element layer for kernels supporting it (requires ALPAKA_ACC_CPU_B_OMP2_T_SEQ_ENABLE)" OFF)
+IF(PMACC_KERNEL_ELEMENT_LAYER)
+    LIST(APPEND _PMACC_COMPILE_DEFINITIONS_PUBLIC "PMACC_KERNEL_ELEMENT_LAYER=1")
+ENDIF(PMACC_KERNEL_ELEMENT_LAYER)
+
 #-------------------------------------------------------------------------------
 # Find alpaka
 # NOTE: Do this first, because it declares `list_add_prefix` and `append_recursive_files_add_to_src_group` used later on.
@@ -24,6 +24,7 @@
 #include "types.hpp"
 #include "math/Vector.hpp"
 #include "mappings/threads/ThreadCollective.hpp"
+#include "mappings/threads/ForEachIdx.hpp"
 #include "nvidia/functors/Assign.hpp"
 #include "memory/boxes/CachedBox.hpp"
 #include "memory/dataTypes/Mask.hpp"
@@ -86,16 +87,12 @@ namespace gol
                 PMacc::DataSpace<DIM2> const gridSuperCellIdxSC(mapper.getSuperCellIndex(blockIdx));
                 // Get the SuperCell index relative to the whole grid in unit of cells.
                 PMacc::DataSpace<DIM2> const gridSuperCellIdxC(gridSuperCellIdxSC * Mapping::SuperCellSize::toRT());
-                // Get the cell index relative to the super cell.
-                PMacc::DataSpace<DIM2> const superCellCellIdxC(alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc));
-                // The cell index relative to the whole grid.
-                PMacc::DataSpace<DIM2> const gridCellIdxC(gridSuperCellIdxC + superCellCellIdxC);
+                // Iterates over the cells of the super cell this thread is responsible for (one cell per thread or all cells as elements of one thread).
+                PMacc::ForEachIdx<typename Mapping::SuperCellSize> const forEachCell(acc);
 
                 //----------
                 // Cache the data of the current block.
 
-                // Create a collective operation (executed by all threads in the block).
-                PMacc::ThreadCollective<BlockArea> collective(superCellCellIdxC);
                 // The collective operation is a simple assignment ...
                 PMacc::nvidia::functors::Assign const assign;
                 // ... into a cache with the size of the block.
@@ -104,11 +101,17 @@ namespace gol
                     BlockArea()));
                 // The input is shifted to the position of the current block inside the input buffer.
                 auto shiftedBuffRead(buffRead.shift(gridSuperCellIdxC));
-                // Execute the collective operation ...
-                collective(
-                    assign,
-                    cache,
-                    shiftedBuffRead);
+                forEachCell(
+                    [&](int const linearCellIdx)
+                    {
+                        // Create a collective operation (executed by all virtual threads in the block).
+                        PMacc::ThreadCollective<BlockArea> collective(linearCellIdx);
+                        // Execute the collective operation ...
+                        collective(
+                            assign,
+                            cache,
+                            shiftedBuffRead);
+                    });
                 // ... resulting in the values from the input buffer corresponding to the current block being cached.
                 // Wait for the collective operation to be finished by all threads.
                 alpaka::block::sync::syncBlockThreads(acc);
@@ -119,21 +122,31 @@ namespace gol
                 // The functor determining if a cell is alive.
                 IsCellAlive const isCellAlive;
 
-                // Count the number of living neighbors.
-                std::uint32_t neighbors(0u);
-                for(std::uint32_t i(1u); i < 9u; ++i)
-                {
-                    PMacc::DataSpace<DIM2> offsetIdxC(PMacc::Mask::getRelativeDirections<DIM2>(i));
-                    neighbors += static_cast<std::uint32_t>(isCellAlive(cache(superCellCellIdxC + offsetIdxC)));
-                }
+                // The output is shifted to the position of the current block inside the output buffer.
+                auto shiftedBuffWrite(buffWrite.shift(gridSuperCellIdxC));
+                forEachCell(
+                    [&](int const linearCellIdx)
+                    {
+                        // Get the cell index relative to the super cell.
+                        PMacc::DataSpace<DIM2> const superCellCellIdxC(
+                            PMacc::DataSpaceOperations<DIM2>::template map<typename Mapping::SuperCellSize>(linearCellIdx));
+
+                        // Count the number of living neighbors.
+                        std::uint32_t neighbors(0u);
+                        for(std::uint32_t i(1u); i < 9u; ++i)
+                        {
+                            PMacc::DataSpace<DIM2> offsetIdxC(PMacc::Mask::getRelativeDirections<DIM2>(i));
+                            neighbors += static_cast<std::uint32_t>(isCellAlive(cache(superCellCellIdxC + offsetIdxC)));
+                        }
 
-                bool const isLife(isCellAlive(cache(superCellCellIdxC)));
-                // The cell is alive after this step if:
-                buffWrite(gridCellIdxC) = static_cast<CellType>(
-                    // - it was alive before and the number of neighbors is in the stay-alive rule.
-                    ((isLife) && ((1 << (neighbors)) & rule)) ||
-                    // - it was dead before and the number of neighbors is in the new-born rule.
-                    ((!isLife) && ((1 << (neighbors + 9)) & rule)) );
+                        bool const isLife(isCellAlive(cache(superCellCellIdxC)));
+                        // The cell is alive after this step if:
+                        shiftedBuffWrite(superCellCellIdxC) = static_cast<CellType>(
+                            // - it was alive before and the number of neighbors is in the stay-alive rule.
+                            ((isLife) && ((1 << (neighbors)) & rule)) ||
+                            // - it was dead before and the number of neighbors is in the new-born rule.
+                            ((!isLife) && ((1 << (neighbors + 9)) & rule)) );
+                    });
             }
         };
 
@@ -242,7 +255,7 @@ namespace gol
             kernel::evolution kernel;
 
             PMacc::AreaMapping<TArea, MappingDesc> mapper(mapping);
-            __cudaKernel(
+            __cudaKernelElements(
                 kernel,
                 alpaka::dim::DimInt<2u>,
                 mapper.getGridDim(),
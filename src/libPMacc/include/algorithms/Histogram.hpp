@@ -0,0 +1,180 @@
+/**
+ * Copyright 2026 agent
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "types.h"
+#include "dimensions/DataSpace.hpp"
+#include "dimensions/DataSpaceOperations.hpp"
+
+#include <type_traits>
+
+/** shared memory in byte which a block histogram may use for its copies
+ *
+ * The number of privatized sub-histograms is chosen such that all copies fit
+ * into this limit, \see algorithms::histogram::BlockHistogram
+ * On CPU the shared memory of a block is ordinary memory, the default is
+ * sized to stay in the L2 cache.
+ */
+#ifndef PMACC_HISTOGRAM_SHARED_BYTES
+#   ifdef PMACC_ACC_CPU
+#       define PMACC_HISTOGRAM_SHARED_BYTES (256 * 1024)
+#   else
+#       define PMACC_HISTOGRAM_SHARED_BYTES (32 * 1024)
+#   endif
+#endif
+
+namespace PMacc
+{
+namespace algorithms
+{
+namespace histogram
+{
+
+/** weighted histogram of a block with privatized sub-histograms
+ *
+ * The bins are held numSubHistograms times in shared memory. A thread adds
+ * to the copy linearThreadIdx % numSubHistograms, thus the atomics of
+ * neighboring threads (a warp on GPU, the OpenMP threads of a block on CPU)
+ * hit different addresses even if all particles fall into a few hot bins.
+ * combine() sums the copies and adds each bin once to global memory.
+ *
+ * Usage in a kernel:
+ *   - get the shared memory (size: getSharedMemSizeBytes())
+ *   - init(), syncBlockThreads
+ *   - add() for each entry, syncBlockThreads
+ *   - combine()
+ *
+ * \tparam T_Type type of a bin
+ * \tparam T_dim dimension of the histogram (1 or 2)
+ */
+template<typename T_Type, unsigned T_dim>
+class BlockHistogram
+{
+public:
+    typedef T_Type ValueType;
+    static const unsigned Dim = T_dim;
+
+    /** number of copies of a histogram
+     *
+     * Must give the same result on host and device.
+     *
+     * @param numBins number of bins of one histogram
+     * @param numThreads number of threads of a block
+     */
+    HDINLINE static uint32_t
+    getNumSubHistograms(const DataSpace<T_dim>& numBins, const uint32_t numThreads)
+    {
+        const uint32_t histogramBytes = numBins.productOfComponents() * sizeof (T_Type);
+        uint32_t numSubHistograms = histogramBytes == 0 ? 1 : PMACC_HISTOGRAM_SHARED_BYTES / histogramBytes;
+        if (numSubHistograms > numThreads)
+            numSubHistograms = numThreads;
+        if (numSubHistograms == 0)
+            numSubHistograms = 1;
+        return numSubHistograms;
+    }
+
+    /** shared memory in byte for all copies of a histogram */
+    HDINLINE static uint32_t
+    getSharedMemSizeBytes(const DataSpace<T_dim>& numBins, const uint32_t numThreads)
+    {
+        return getNumSubHistograms(numBins, numThreads) * numBins.productOfComponents() * sizeof (T_Type);
+    }
+
+    /** constructor
+     *
+     * @param sharedMem shared memory of getSharedMemSizeBytes() byte
+     * @param numBins number of bins
+     * @param linearThreadIdx linear index of this thread in the block
+     * @param numThreads number of threads of the block
+     */
+    HDINLINE BlockHistogram(T_Type* const sharedMem,
+                            const DataSpace<T_dim>& numBins,
+                            const uint32_t linearThreadIdx,
+                            const uint32_t numThreads) :
+    sharedMem(sharedMem),
+    numBins(numBins),
+    numBinsLinear(numBins.productOfComponents()),
+    numSubHistograms(getNumSubHistograms(numBins, numThreads)),
+    linearThreadIdx(linearThreadIdx),
+    numThreads(numThreads)
+    {
+    }
+
+    /** set all bins of all copies to zero */
+    template<typename T_Acc>
+    DINLINE void init(const T_Acc&) const
+    {
+        const uint32_t size = numSubHistograms * numBinsLinear;
+        for (uint32_t i = linearThreadIdx; i < size; i += numThreads)
+            sharedMem[i] = T_Type(0.0);
+    }
+
+    /** add a weighted entry
+     *
+     * @param bin index of the bin, must be in [0, numBins)
+     * @param weight value added to the bin
+     */
+    template<typename T_Acc>
+    DINLINE void add(const T_Acc& acc, const DataSpace<T_dim>& bin, const T_Type weight) const
+    {
+        const uint32_t linearBin = DataSpaceOperations<T_dim>::map(numBins, bin);
+        T_Type* const subHistogram = sharedMem + (linearThreadIdx % numSubHistograms) * numBinsLinear;
+        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(subHistogram[linearBin]), weight);
+    }
+
+    /** add the sum of all copies to a global histogram
+     *
+     * @param dest box with operator()(DataSpace<T_dim>) which returns a
+     *             reference to the bin in global memory
+     */
+    template<typename T_Acc, typename T_DestBox>
+    DINLINE void combine(const T_Acc& acc, const T_DestBox& dest) const
+    {
+        for (uint32_t i = linearThreadIdx; i < numBinsLinear; i += numThreads)
+        {
+            T_Type sum = sharedMem[i];
+            for (uint32_t s = 1; s < numSubHistograms; ++s)
+                sum += sharedMem[s * numBinsLinear + i];
+
+            /* empty bins are not written, most bins are empty for most blocks */
+            if (sum == T_Type(0.0))
+                continue;
+
+            const DataSpace<T_dim> bin(DataSpaceOperations<T_dim>::map(numBins, i));
+            typedef typename std::remove_reference<decltype(dest(bin))>::type DestType;
+            alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(dest(bin)), static_cast<DestType>(sum));
+        }
+    }
+
+private:
+    T_Type* const sharedMem;
+    const DataSpace<T_dim> numBins;
+    const uint32_t numBinsLinear;
+    const uint32_t numSubHistograms;
+    const uint32_t linearThreadIdx;
+    const uint32_t numThreads;
+};
+
+} // namespace histogram
+} // namespace algorithms
+} // namespace PMacc
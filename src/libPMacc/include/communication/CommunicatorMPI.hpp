@@ -34,6 +34,8 @@
 #include <vector>
 #include <utility>
 #include <map>
+#include <set>
+#include <tuple>
 
 namespace PMacc
 {
@@ -43,6 +45,23 @@ namespace PMacc
 template <unsigned DIM>
 class CommunicatorMPI : public ICommunicator
 {
+private:
+    //! persistent MPI request of one exchange
+    struct PersistentRequest
+    {
+        MPI_Request request;
+        //! buffer and message size the request was created for
+        char *data;
+        size_t count;
+        //! true between MPI_Start and releaseRequest
+        bool active;
+    };
+
+    //! (is send, exchange type, tag)
+    typedef std::tuple<bool, uint32_t, uint32_t> PersistentKey;
+    typedef std::map<PersistentKey, PersistentRequest*> PersistentMap;
+    typedef std::map<MPI_Request*, PersistentRequest*> RequestOwnerMap;
+
 public:
 
     /*! ctor
@@ -54,10 +73,14 @@ public:
 
     /*! dtor
      *
-     * calls MPI_Finalize
+     * frees all pooled requests
      */
     virtual ~CommunicatorMPI()
-    {}
+    {
+        freePersistentRequests();
+        for (size_t i = 0; i < requestPool.size(); ++i)
+            delete requestPool[i];
+    }
 
     virtual int getRank()
     {
@@ -155,7 +178,14 @@ public:
 
     MPI_Request* startSend(uint32_t ex, const char *send_data, size_t send_data_count, uint32_t tag)
     {
-        MPI_Request *request = new MPI_Request;
+        PersistentRequest* persistent = getPersistentRequest(true, ex, const_cast<char*>(send_data), send_data_count, tag);
+        if (persistent != NULL)
+        {
+            MPI_CHECK(MPI_Start(&(persistent->request)));
+            return &(persistent->request);
+        }
+
+        MPI_Request *request = getPooledRequest();
 
         MPI_CHECK(MPI_Isend(
                             (void*) send_data,
@@ -173,8 +203,14 @@ public:
 
     MPI_Request* startReceive(uint32_t ex, char *recv_data, size_t recv_data_max, uint32_t tag)
     {
+        PersistentRequest* persistent = getPersistentRequest(false, ex, recv_data, recv_data_max, tag);
+        if (persistent != NULL)
+        {
+            MPI_CHECK(MPI_Start(&(persistent->request)));
+            return &(persistent->request);
+        }
 
-        MPI_Request *request = new MPI_Request;
+        MPI_Request *request = getPooledRequest();
 
         MPI_CHECK(MPI_Irecv(
                             recv_data,
@@ -190,6 +226,56 @@ public:
 
     // description in ICommunicator
 
+    void releaseRequest(MPI_Request* request)
+    {
+        typename RequestOwnerMap::iterator it = requestOwner.find(request);
+        if (it != requestOwner.end())
+        {
+            /* persistent request is inactive after MPI_Test and can be restarted */
+            it->second->active = false;
+            return;
+        }
+        requestPool.push_back(request);
+    }
+
+    // description in ICommunicator
+
+    bool testRequest(MPI_Request* request, MPI_Status* status)
+    {
+        int flag = 0;
+        MPI_CHECK(MPI_Test(request, &flag, status));
+        return flag != 0;
+    }
+
+    // description in ICommunicator
+
+    void registerExchangeTag(uint32_t)
+    {
+    }
+
+    // description in ICommunicator
+
+    void setMultiRoundExchange(uint32_t, uint32_t)
+    {
+    }
+
+    // description in ICommunicator
+
+    void finishExchangeRegistration()
+    {
+    }
+
+    /*! converts an exchangeType (e.g. RIGHT) to an MPI-rank
+     *
+     * @return -1 if there is no neighbor in this direction
+     */
+    int ExchangeTypeToRank(uint32_t type)
+    {
+        return ranks[type];
+    }
+
+    // description in ICommunicator
+
     bool slide()
     {
         // MPI_Barrier(topology);
@@ -198,6 +284,8 @@ public:
             yoffset = 0;
 
         updateCoordinates();
+        /* neighbor ranks changed, persistent requests are rebuilt on next use */
+        freePersistentRequests();
         if (DIM >= DIM2)
         {
             if (coordinates[1] == dims[1] - 1)
@@ -368,14 +456,112 @@ protected:
         }
     }
 
-    /*! converts an exchangeType (e.g. RIGHT) to an MPI-rank
+    /*! get a persistent request for an exchange
+     *
+     * Persistent requests are only used for fixed-size exchanges (e.g.
+     * fields): a request is created once per direction, exchange type and
+     * tag. If buffer or message size of an exchange change (e.g. particles)
+     * the request is freed and the exchange uses MPI_Isend/MPI_Irecv from
+     * then on.
+     *
+     * @return NULL if the exchange has no persistent request (caller must
+     *         fall back to a non-persistent request)
      */
-    int ExchangeTypeToRank(uint32_t type)
+    PersistentRequest* getPersistentRequest(bool isSend, uint32_t ex, char *data, size_t count, uint32_t tag)
     {
-        return ranks[type];
+        const PersistentKey key(isSend, ex, tag);
+        if (variableSizeExchanges.count(key) != 0)
+            return NULL;
+
+        PersistentRequest* &persistent = persistentRequests[key];
+
+        if (persistent != NULL && persistent->active)
+            return NULL;
+
+        if (persistent != NULL && (persistent->data != data || persistent->count != count))
+        {
+            requestOwner.erase(&(persistent->request));
+            MPI_CHECK(MPI_Request_free(&(persistent->request)));
+            delete persistent;
+            persistentRequests.erase(key);
+            variableSizeExchanges.insert(key);
+            return NULL;
+        }
+
+        if (persistent == NULL)
+        {
+            persistent = new PersistentRequest;
+            persistent->data = data;
+            persistent->count = count;
+            persistent->active = false;
+            if (isSend)
+                MPI_CHECK(MPI_Send_init(
+                                        (void*) data,
+                                        static_cast<int>(count),
+                                        MPI_CHAR,
+                                        ExchangeTypeToRank(ex),
+                                        gridExchangeTag + tag,
+                                        topology,
+                                        &(persistent->request)));
+            else
+                MPI_CHECK(MPI_Recv_init(
+                                        data,
+                                        static_cast<int>(count),
+                                        MPI_CHAR,
+                                        ExchangeTypeToRank(ex),
+                                        gridExchangeTag + tag,
+                                        topology,
+                                        &(persistent->request)));
+            requestOwner[&(persistent->request)] = persistent;
+        }
+
+        persistent->active = true;
+        return persistent;
+    }
+
+    /*! get a request from the pool (or allocate one if the pool is empty)
+     */
+    MPI_Request* getPooledRequest()
+    {
+        if (requestPool.empty())
+            return new MPI_Request;
+
+        MPI_Request* request = requestPool.back();
+        requestPool.pop_back();
+        return request;
+    }
+
+    /*! free all persistent requests
+     *
+     * must only be called if no communication is in flight
+     */
+    void freePersistentRequests()
+    {
+        int finalized = 0;
+        MPI_CHECK_NOEXCEPT(MPI_Finalized(&finalized));
+
+        for (typename PersistentMap::iterator it = persistentRequests.begin();
+             it != persistentRequests.end(); ++it)
+        {
+            if (it->second == NULL)
+                continue;
+            if (!finalized)
+                MPI_CHECK_NOEXCEPT(MPI_Request_free(&(it->second->request)));
+            delete it->second;
+        }
+        persistentRequests.clear();
+        requestOwner.clear();
     }
 
 private:
+    PersistentMap persistentRequests;
+    //! exchanges with changing buffer or message size, never persistent
+    std::set<PersistentKey> variableSizeExchanges;
+    //! map handle returned by startSend/startReceive to its persistent request
+    RequestOwnerMap requestOwner;
+    //! finished non-persistent requests for reuse
+    std::vector<MPI_Request*> requestPool;
+
     //! coordinates in GPU-Grid [0:cx-1,0:cy-1,0:cz-1]
     DataSpace<DIM> coordinates;
 
@@ -0,0 +1,645 @@
+/**
+ * Copyright 2013, 2015 Rene Widera, Wolfgang Hoenig, Benjamin Worpitz
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "communication/ICommunicator.hpp"
+#include "communication/CommunicatorMPI.hpp"
+#include "communication/manager_common.h"
+#include "memory/dataTypes/Mask.hpp"
+#include "types.h"
+
+#include <mpi.h>
+
+#include <vector>
+#include <deque>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace PMacc
+{
+
+#if (MPI_VERSION >= 3)
+
+/*! communication via MPI-3 neighborhood collectives
+ *
+ * All exchanges with the same communicationTag (tag >> 5, \see GridBuffer)
+ * form a group with its own distributed graph communicator which connects
+ * the neighbors of all registered directions. A round of a group starts
+ * if a message is posted for each edge of the graph and exchanges all
+ * directions at once: first the message sizes with MPI_Ineighbor_alltoall,
+ * then the data with MPI_Ineighbor_alltoallw (the exchange buffers are
+ * addressed relative to MPI_BOTTOM, no staging copy is needed).
+ *
+ * Tags which were not registered with registerExchangeTag() and further
+ * messages of multi round exchanges (\see setMultiRoundExchange) are sent
+ * point-to-point with the wrapped CommunicatorMPI.
+ */
+template <unsigned DIM>
+class CommunicatorNeighborMPI : public ICommunicator
+{
+private:
+
+    enum
+    {
+        NumExchanges = 27
+    };
+
+    //! round state of a group
+    enum RoundState
+    {
+        Idle,
+        ExchangeSizes,
+        ExchangeData
+    };
+
+    struct Group;
+
+    //! message posted with startSend or startReceive
+    struct Message
+    {
+        //! handle returned to the caller, never passed to MPI
+        MPI_Request request;
+        Group *group;
+        char *data;
+        //! bytes to send or maximum bytes to receive
+        size_t count;
+        //! received bytes
+        size_t receivedCount;
+        bool finished;
+    };
+
+    //! point-to-point message of a group (\see setMultiRoundExchange)
+    struct PointToPointMessage
+    {
+        Group *group;
+        uint32_t ex;
+        bool isSend;
+        size_t count;
+    };
+
+    //! all exchanges with the same communicationTag
+    struct Group
+    {
+        uint32_t communicationTag;
+        MPI_Comm graph;
+        //! graph must be (re)built before the next round
+        bool isDirty;
+        //! tag of direction ex is registered
+        bool isRegistered[NumExchanges];
+        //! edge index of a send direction / receive direction in the graph, -1 if no edge
+        int sendEdge[NumExchanges];
+        int receiveEdge[NumExchanges];
+        std::vector<uint32_t> sendDirections;
+        std::vector<uint32_t> receiveDirections;
+
+        std::deque<Message*> sends[NumExchanges];
+        std::deque<Message*> receives[NumExchanges];
+
+        RoundState state;
+        MPI_Request roundRequest;
+        std::vector<Message*> roundSends;
+        std::vector<Message*> roundReceives;
+        //! per edge: message size and receive capacity of the sender
+        std::vector<uint64_t> sendSizes;
+        std::vector<uint64_t> receiveSizes;
+        std::vector<int> sendCounts;
+        std::vector<int> receiveCounts;
+        std::vector<MPI_Aint> sendDispls;
+        std::vector<MPI_Aint> receiveDispls;
+        std::vector<MPI_Datatype> sendTypes;
+        std::vector<MPI_Datatype> receiveTypes;
+
+        //! communicationTag of the group which decides if a further message follows
+        uint32_t leaderTag;
+        bool isMultiRound;
+        //! receive capacity of the neighbor in send direction ex
+        size_t peerCapacity[NumExchanges];
+        //! last message filled the receive buffer, a further message follows
+        bool sendFollows[NumExchanges];
+        bool receiveFollows[NumExchanges];
+    };
+
+    typedef std::map<uint32_t, Group*> GroupMap;
+    typedef std::map<MPI_Request*, Message*> MessageMap;
+    typedef std::map<MPI_Request*, PointToPointMessage> PointToPointMap;
+
+public:
+
+    /*! ctor
+     *
+     * @param pointToPoint initialized communicator which describes the topology
+     */
+    CommunicatorNeighborMPI(CommunicatorMPI<DIM>& pointToPoint) : pointToPoint(pointToPoint)
+    {
+    }
+
+    virtual ~CommunicatorNeighborMPI()
+    {
+        int finalized = 0;
+        MPI_CHECK_NOEXCEPT(MPI_Finalized(&finalized));
+
+        for (typename GroupMap::iterator it = groups.begin(); it != groups.end(); ++it)
+        {
+            if (!finalized && it->second->graph != MPI_COMM_NULL)
+                MPI_CHECK_NOEXCEPT(MPI_Comm_free(&(it->second->graph)));
+            delete it->second;
+        }
+        for (typename MessageMap::iterator it = messages.begin(); it != messages.end(); ++it)
+            delete it->second;
+    }
+
+    virtual int getRank()
+    {
+        return pointToPoint.getRank();
+    }
+
+    // description in ICommunicator
+
+    virtual const Mask& getCommunicationMask() const
+    {
+        return pointToPoint.getCommunicationMask();
+    }
+
+    // description in ICommunicator
+
+    bool slide()
+    {
+        bool result = pointToPoint.slide();
+        invalidateGraphs();
+        return result;
+    }
+
+    // description in ICommunicator
+
+    bool setStateAfterSlides(size_t numSlides)
+    {
+        bool result = pointToPoint.setStateAfterSlides(numSlides);
+        invalidateGraphs();
+        return result;
+    }
+
+    // description in ICommunicator
+
+    void registerExchangeTag(uint32_t tag)
+    {
+        Group &group = getGroup(tag >> 5);
+        group.isRegistered[tag & 31u] = true;
+        group.isDirty = true;
+    }
+
+    // description in ICommunicator
+
+    void setMultiRoundExchange(uint32_t communicationTag, uint32_t leaderTag)
+    {
+        Group &group = getGroup(communicationTag);
+        group.isMultiRound = true;
+        group.leaderTag = leaderTag;
+    }
+
+    // description in ICommunicator
+
+    void finishExchangeRegistration()
+    {
+        buildGraphs();
+    }
+
+    // description in ICommunicator
+
+    MPI_Request* startSend(uint32_t ex, const char *send_data, size_t send_data_count, uint32_t tag)
+    {
+        Group *group = findGroup(tag);
+        if (group == NULL)
+            return pointToPoint.startSend(ex, send_data, send_data_count, tag);
+
+        if (getLeader(*group).sendFollows[ex])
+        {
+            MPI_Request *request = pointToPoint.startSend(ex, send_data, send_data_count, tag);
+            PointToPointMessage message = {group, ex, true, send_data_count};
+            pointToPointMessages[request] = message;
+            return request;
+        }
+
+        Message *message = newMessage(*group, const_cast<char*>(send_data), send_data_count);
+        group->sends[ex].push_back(message);
+        progress(*group);
+        return &(message->request);
+    }
+
+    // description in ICommunicator
+
+    MPI_Request* startReceive(uint32_t ex, char *recv_data, size_t recv_data_max, uint32_t tag)
+    {
+        Group *group = findGroup(tag);
+        if (group == NULL)
+            return pointToPoint.startReceive(ex, recv_data, recv_data_max, tag);
+
+        if (getLeader(*group).receiveFollows[ex])
+        {
+            MPI_Request *request = pointToPoint.startReceive(ex, recv_data, recv_data_max, tag);
+            PointToPointMessage message = {group, ex, false, recv_data_max};
+            pointToPointMessages[request] = message;
+            return request;
+        }
+
+        Message *message = newMessage(*group, recv_data, recv_data_max);
+        group->receives[ex].push_back(message);
+        progress(*group);
+        return &(message->request);
+    }
+
+    // description in ICommunicator
+
+    bool testRequest(MPI_Request* request, MPI_Status* status)
+    {
+        typename MessageMap::iterator it = messages.find(request);
+        if (it != messages.end())
+        {
+            Message *message = it->second;
+            progress(*(message->group));
+            if (!message->finished)
+                return false;
+            MPI_CHECK(MPI_Status_set_elements(status, MPI_CHAR, static_cast<int>(message->receivedCount)));
+            return true;
+        }
+
+        if (!pointToPoint.testRequest(request, status))
+            return false;
+
+        typename PointToPointMap::iterator p2p = pointToPointMessages.find(request);
+        if (p2p != pointToPointMessages.end())
+        {
+            PointToPointMessage &message = p2p->second;
+            if (message.isSend)
+                finishSend(*(message.group), message.ex, message.count);
+            else
+            {
+                int count;
+                MPI_CHECK(MPI_Get_count(status, MPI_CHAR, &count));
+                finishReceive(*(message.group), message.ex, static_cast<size_t>(count), message.count);
+            }
+            pointToPointMessages.erase(p2p);
+        }
+        return true;
+    }
+
+    // description in ICommunicator
+
+    void releaseRequest(MPI_Request* request)
+    {
+        typename MessageMap::iterator it = messages.find(request);
+        if (it != messages.end())
+        {
+            delete it->second;
+            messages.erase(it);
+            return;
+        }
+        pointToPoint.releaseRequest(request);
+    }
+
+private:
+
+    Group& getGroup(uint32_t communicationTag)
+    {
+        Group* &group = groups[communicationTag];
+        if (group == NULL)
+        {
+            group = new Group;
+            group->communicationTag = communicationTag;
+            group->graph = MPI_COMM_NULL;
+            group->isDirty = true;
+            group->state = Idle;
+            group->roundRequest = MPI_REQUEST_NULL;
+            group->leaderTag = communicationTag;
+            group->isMultiRound = false;
+            for (uint32_t ex = 0; ex < NumExchanges; ++ex)
+            {
+                group->isRegistered[ex] = false;
+                group->sendEdge[ex] = -1;
+                group->receiveEdge[ex] = -1;
+                group->peerCapacity[ex] = 0;
+                group->sendFollows[ex] = false;
+                group->receiveFollows[ex] = false;
+            }
+        }
+        return *group;
+    }
+
+    /*! group of a tag, NULL if the tag was not registered
+     *
+     * Groups without graph (registered after finishExchangeRegistration())
+     * are sent point-to-point, building the graph is collective and only
+     * done at finishExchangeRegistration() and slides.
+     */
+    Group* findGroup(uint32_t tag)
+    {
+        typename GroupMap::iterator it = groups.find(tag >> 5);
+        if (it == groups.end() || !it->second->isRegistered[tag & 31u])
+            return NULL;
+
+        if (it->second->isDirty)
+            return NULL;
+        return it->second;
+    }
+
+    Group& getLeader(Group& group)
+    {
+        if (!group.isMultiRound)
+            return group;
+        return getGroup(group.leaderTag);
+    }
+
+    Message* newMessage(Group& group, char *data, size_t count)
+    {
+        Message *message = new Message;
+        message->request = MPI_REQUEST_NULL;
+        message->group = &group;
+        message->data = data;
+        message->count = count;
+        message->receivedCount = 0;
+        message->finished = false;
+        messages[&(message->request)] = message;
+        return message;
+    }
+
+    void invalidateGraphs()
+    {
+        for (typename GroupMap::iterator it = groups.begin(); it != groups.end(); ++it)
+            it->second->isDirty = true;
+        buildGraphs();
+    }
+
+    /*! build the graph communicators of all changed groups (collective)
+     *
+     * The edges to a neighbor are ordered by the direction of the sender,
+     * therefore multiple edges between two ranks (periodic boundaries with
+     * few ranks) are matched in the same order on both sides.
+     * Must only be called if no message of the rebuilt groups is in flight.
+     */
+    void buildGraphs()
+    {
+        const Mask &mask = pointToPoint.getCommunicationMask();
+
+        for (typename GroupMap::iterator it = groups.begin(); it != groups.end(); ++it)
+        {
+            Group &group = *(it->second);
+            if (!group.isDirty)
+                continue;
+
+            if (!isIdle(group))
+            {
+                std::stringstream message;
+                message << "neighbor communicator: graph of communicationTag " << group.communicationTag
+                    << " rebuilt while a round is in flight";
+                throw std::runtime_error(message.str());
+            }
+
+            if (group.graph != MPI_COMM_NULL)
+                MPI_CHECK(MPI_Comm_free(&(group.graph)));
+
+            std::vector<int> destinations;
+            std::vector<int> sources;
+            group.sendDirections.clear();
+            group.receiveDirections.clear();
+            for (uint32_t ex = 1; ex < NumExchanges; ++ex)
+            {
+                group.sendEdge[ex] = -1;
+                group.receiveEdge[ex] = -1;
+            }
+            for (uint32_t ex = 1; ex < NumExchanges; ++ex)
+            {
+                if (!group.isRegistered[ex])
+                    continue;
+
+                if (mask.isSet(ex))
+                {
+                    group.sendEdge[ex] = static_cast<int>(destinations.size());
+                    group.sendDirections.push_back(ex);
+                    destinations.push_back(pointToPoint.ExchangeTypeToRank(ex));
+                }
+                /* the neighbor in direction recvEx sends in direction ex */
+                const uint32_t recvEx = Mask::getMirroredExchangeType(ex);
+                if (mask.isSet(recvEx))
+                {
+                    group.receiveEdge[recvEx] = static_cast<int>(sources.size());
+                    group.receiveDirections.push_back(recvEx);
+                    sources.push_back(pointToPoint.ExchangeTypeToRank(recvEx));
+                }
+            }
+
+            /* MPI does not accept NULL for empty neighbor lists */
+            int empty = 0;
+            MPI_CHECK(MPI_Dist_graph_create_adjacent(
+                                                     pointToPoint.getMPIComm(),
+                                                     static_cast<int>(sources.size()),
+                                                     sources.empty() ? &empty : &sources[0],
+                                                     MPI_UNWEIGHTED,
+                                                     static_cast<int>(destinations.size()),
+                                                     destinations.empty() ? &empty : &destinations[0],
+                                                     MPI_UNWEIGHTED,
+                                                     MPI_INFO_NULL,
+                                                     0,
+                                                     &(group.graph)));
+
+            const size_t numSends = destinations.size();
+            const size_t numReceives = sources.size();
+            group.roundSends.assign(numSends, NULL);
+            group.roundReceives.assign(numReceives, NULL);
+            group.sendSizes.assign(2 * numSends, 0);
+            group.receiveSizes.assign(2 * numReceives, 0);
+            group.sendCounts.assign(numSends, 0);
+            group.receiveCounts.assign(numReceives, 0);
+            group.sendDispls.assign(numSends, 0);
+            group.receiveDispls.assign(numReceives, 0);
+            group.sendTypes.assign(numSends, MPI_CHAR);
+            group.receiveTypes.assign(numReceives, MPI_CHAR);
+            group.isDirty = false;
+        }
+    }
+
+    /*! true if no round of a group is in flight and no message is queued
+     */
+    bool isIdle(const Group& group) const
+    {
+        if (group.state != Idle)
+            return false;
+        for (uint32_t ex = 0; ex < NumExchanges; ++ex)
+        {
+            if (!group.sends[ex].empty() || !group.receives[ex].empty())
+                return false;
+        }
+        return true;
+    }
+
+    /*! drive the round of a group
+     *
+     * A round starts if a message is posted for every edge and is finished
+     * in two steps (message sizes, data).
+     */
+    void progress(Group& group)
+    {
+        int flag = 0;
+        if (group.state == ExchangeSizes)
+        {
+            MPI_CHECK(MPI_Test(&(group.roundRequest), &flag, MPI_STATUS_IGNORE));
+            if (flag)
+                startData(group);
+        }
+        if (group.state == ExchangeData)
+        {
+            MPI_CHECK(MPI_Test(&(group.roundRequest), &flag, MPI_STATUS_IGNORE));
+            if (flag)
+                finishRound(group);
+        }
+        if (group.state == Idle)
+            startRound(group);
+    }
+
+    void startRound(Group& group)
+    {
+        if (group.sendDirections.empty() && group.receiveDirections.empty())
+            return;
+
+        for (size_t i = 0; i < group.sendDirections.size(); ++i)
+            if (group.sends[group.sendDirections[i]].empty())
+                return;
+        for (size_t i = 0; i < group.receiveDirections.size(); ++i)
+            if (group.receives[group.receiveDirections[i]].empty())
+                return;
+
+        for (size_t i = 0; i < group.sendDirections.size(); ++i)
+        {
+            const uint32_t ex = group.sendDirections[i];
+            Message *message = group.sends[ex].front();
+            group.sends[ex].pop_front();
+            group.roundSends[group.sendEdge[ex]] = message;
+            group.sendSizes[2 * group.sendEdge[ex]] = message->count;
+        }
+        for (size_t i = 0; i < group.receiveDirections.size(); ++i)
+        {
+            const uint32_t ex = group.receiveDirections[i];
+            Message *message = group.receives[ex].front();
+            group.receives[ex].pop_front();
+            group.roundReceives[group.receiveEdge[ex]] = message;
+            /* tell the neighbor in direction ex our receive capacity */
+            const int sendEdge = group.sendEdge[ex];
+            if (sendEdge >= 0)
+                group.sendSizes[2 * sendEdge + 1] = message->count;
+        }
+
+        MPI_CHECK(MPI_Ineighbor_alltoall(
+                                         group.sendSizes.empty() ? NULL : &group.sendSizes[0],
+                                         2,
+                                         MPI_UINT64_T,
+                                         group.receiveSizes.empty() ? NULL : &group.receiveSizes[0],
+                                         2,
+                                         MPI_UINT64_T,
+                                         group.graph,
+                                         &(group.roundRequest)));
+        group.state = ExchangeSizes;
+    }
+
+    void startData(Group& group)
+    {
+        for (size_t i = 0; i < group.roundSends.size(); ++i)
+        {
+            Message *message = group.roundSends[i];
+            group.sendCounts[i] = static_cast<int>(message->count);
+            MPI_CHECK(MPI_Get_address(message->data, &(group.sendDispls[i])));
+        }
+        for (size_t i = 0; i < group.roundReceives.size(); ++i)
+        {
+            Message *message = group.roundReceives[i];
+            message->receivedCount = static_cast<size_t>(group.receiveSizes[2 * i]);
+            if (message->receivedCount > message->count)
+            {
+                std::stringstream error;
+                error << "[MPI] neighbor sends " << message->receivedCount << " bytes, receive buffer holds "
+                    << message->count << " bytes (communicationTag " << group.communicationTag << ")";
+                throw std::runtime_error(error.str());
+            }
+            group.receiveCounts[i] = static_cast<int>(message->receivedCount);
+            MPI_CHECK(MPI_Get_address(message->data, &(group.receiveDispls[i])));
+        }
+        /* the neighbor in direction ex is also the destination of our sends in direction ex */
+        for (size_t i = 0; i < group.receiveDirections.size(); ++i)
+        {
+            const uint32_t ex = group.receiveDirections[i];
+            group.peerCapacity[ex] = static_cast<size_t>(group.receiveSizes[2 * group.receiveEdge[ex] + 1]);
+        }
+
+        MPI_CHECK(MPI_Ineighbor_alltoallw(
+                                          MPI_BOTTOM,
+                                          group.sendCounts.empty() ? NULL : &group.sendCounts[0],
+                                          group.sendDispls.empty() ? NULL : &group.sendDispls[0],
+                                          group.sendTypes.empty() ? NULL : &group.sendTypes[0],
+                                          MPI_BOTTOM,
+                                          group.receiveCounts.empty() ? NULL : &group.receiveCounts[0],
+                                          group.receiveDispls.empty() ? NULL : &group.receiveDispls[0],
+                                          group.receiveTypes.empty() ? NULL : &group.receiveTypes[0],
+                                          group.graph,
+                                          &(group.roundRequest)));
+        group.state = ExchangeData;
+    }
+
+    void finishRound(Group& group)
+    {
+        for (size_t i = 0; i < group.sendDirections.size(); ++i)
+        {
+            const uint32_t ex = group.sendDirections[i];
+            Message *message = group.roundSends[group.sendEdge[ex]];
+            message->receivedCount = message->count;
+            message->finished = true;
+            finishSend(group, ex, message->count);
+        }
+        for (size_t i = 0; i < group.receiveDirections.size(); ++i)
+        {
+            const uint32_t ex = group.receiveDirections[i];
+            Message *message = group.roundReceives[group.receiveEdge[ex]];
+            message->finished = true;
+            finishReceive(group, ex, message->receivedCount, message->count);
+        }
+        group.state = Idle;
+    }
+
+    void finishSend(Group& group, uint32_t ex, size_t count)
+    {
+        if (group.isMultiRound)
+            group.sendFollows[ex] = (count == group.peerCapacity[ex]);
+    }
+
+    void finishReceive(Group& group, uint32_t ex, size_t count, size_t capacity)
+    {
+        if (group.isMultiRound)
+            group.receiveFollows[ex] = (count == capacity);
+    }
+
+    CommunicatorMPI<DIM>& pointToPoint;
+    GroupMap groups;
+    MessageMap messages;
+    PointToPointMap pointToPointMessages;
+};
+
+#endif
+
+} //namespace PMacc
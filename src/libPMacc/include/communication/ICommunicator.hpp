@@ -75,6 +75,54 @@ public:
      */
     virtual MPI_Request* startReceive(uint32_t ex, char *recv_data, size_t recv_data_max, uint32_t tag) = 0;
 
+    /*! give a finished request back to the communicator
+     *
+     * Requests returned by startSend and startReceive are owned by the
+     * communicator and must not be deleted by the caller.
+     *
+     * \param[in] request          request which was tested successfully (MPI_Test)
+     */
+    virtual void releaseRequest(MPI_Request* request) = 0;
+
+    /*! test if a request returned by startSend or startReceive has finished (non-blocking)
+     *
+     * Replaces MPI_Test for these requests, a communicator can drive its own
+     * pending operations while the request is tested.
+     *
+     * \param[in] request          request of startSend or startReceive
+     * \param[out] status          status of the finished operation (MPI_Get_count returns the message size)
+     * \returns true if the operation has finished, the request must be given back with releaseRequest
+     */
+    virtual bool testRequest(MPI_Request* request, MPI_Status* status) = 0;
+
+    /*! announce the tag of an exchange before the first message is sent
+     *
+     * Must be called for the tags of all directions of an exchange
+     * (independent of the existing neighbors) in the same order on all ranks.
+     *
+     * \param[in] tag              tag used in startSend for the direction and in startReceive for the mirrored direction
+     */
+    virtual void registerExchangeTag(uint32_t tag) = 0;
+
+    /*! mark an exchange which can need more than one message per direction
+     *
+     * A message which fills the receive buffer is followed by a further
+     * message in the same direction (e.g. particles).
+     *
+     * \param[in] communicationTag tag of the exchange without direction (tag >> 5)
+     * \param[in] leaderTag        communicationTag of an exchange which decides if a further
+     *                             message follows, if it is sent together with it
+     */
+    virtual void setMultiRoundExchange(uint32_t communicationTag, uint32_t leaderTag) = 0;
+
+    /*! all exchange tags are registered (collective)
+     *
+     * Must be called on all ranks after the buffers of the simulation are
+     * created and before their first communication. Tags registered later
+     * can be slower until the next call of slide().
+     */
+    virtual void finishExchangeRegistration() = 0;
+
     virtual int getRank()=0;
 
 };
@@ -47,6 +47,48 @@
     #define PMACC_KERNEL_CATCH(MSG, COMMAND)
 #endif
 
+namespace PMacc
+{
+#if (PMACC_KERNEL_ELEMENT_LAYER == 1)
+    #if !defined(PMACC_ACC_CPU) || !defined(ALPAKA_ACC_CPU_B_OMP2_T_SEQ_ENABLED)
+        #error "PMACC_KERNEL_ELEMENT_LAYER=1 requires a CPU build with ALPAKA_ACC_CPU_B_OMP2_T_SEQ_ENABLE"
+    #endif
+    template<
+        typename TDim>
+    using AlpakaAccElements = alpaka::acc::AccCpuOmp2Blocks<TDim, AlpakaIdxSize>;
+#else
+    template<
+        typename TDim>
+    using AlpakaAccElements = AlpakaAcc<TDim>;
+#endif
+
+    /** create the work division for a kernel written for the element layer
+     *
+     * @param gridExtent number of blocks
+     * @param blockExtent number of cells (virtual threads) per block
+     */
+    template<
+        typename T_Dim,
+        typename T_GridExtent,
+        typename T_BlockExtent>
+    HINLINE ::alpaka::workdiv::WorkDivMembers<T_Dim, AlpakaIdxSize> getWorkDivElements(
+        T_GridExtent const & gridExtent,
+        T_BlockExtent const & blockExtent)
+    {
+#if (PMACC_KERNEL_ELEMENT_LAYER == 1)
+        return ::alpaka::workdiv::WorkDivMembers<T_Dim, AlpakaIdxSize>(
+            gridExtent,
+            static_cast<AlpakaIdxSize>(1u),
+            blockExtent);
+#else
+        return ::alpaka::workdiv::WorkDivMembers<T_Dim, AlpakaIdxSize>(
+            gridExtent,
+            blockExtent,
+            static_cast<AlpakaIdxSize>(1u));
+#endif
+    }
+} //namespace PMacc
+
 /** Call activate kernel from taskKernel.
  *  If PMACC_SYNC_KERNEL is 1 cudaDeviceSynchronize() is called before
  *  and after activation.
@@ -55,9 +97,9 @@
  */
 #define PMACC_ACTIVATE_KERNEL()\
     ::alpaka::stream::enqueue(taskKernel->getEventStream()->getCudaStream(), exec);\
-    PMACC_KERNEL_CATCH(::alpaka::wait::wait(::PMacc::Environment<>::get().DeviceManager().getAccDevice()), "__cudaKernel: crash after kernel call");\
+    PMACC_KERNEL_CATCH(::PMacc::Environment<>::get().StreamController().waitForAll(), "__cudaKernel: crash after kernel call");\
     taskKernel->activateChecks();\
-    PMACC_KERNEL_CATCH(::alpaka::wait::wait(::PMacc::Environment<>::get().DeviceManager().getAccDevice()), "__cudaKernel: crash after kernel activation");\
+    PMACC_KERNEL_CATCH(::PMacc::Environment<>::get().StreamController().waitForAll(), "__cudaKernel: crash after kernel activation");\
 
 /**
  * Appends kernel arguments to the executor invocation and activates the kernel task.
@@ -84,7 +126,20 @@
  */
 #define __cudaKernel(KERNEL, DIM, ...)\
     {\
-        PMACC_KERNEL_CATCH(::alpaka::wait::wait(::PMacc::Environment<>::get().DeviceManager().getAccDevice()), "__cudaKernel: crash before kernel call");\
+        PMACC_KERNEL_CATCH(::PMacc::Environment<>::get().StreamController().waitForAll(), "__cudaKernel: crash before kernel call");\
         ::PMacc::TaskKernel * const taskKernel(::PMacc::Environment<>::get().Factory().createTaskKernel(#KERNEL));\
         auto const exec(::alpaka::exec::create<::PMacc::AlpakaAcc<DIM>>(::alpaka::workdiv::WorkDivMembers<DIM, ::PMacc::AlpakaIdxSize>(__VA_ARGS__,static_cast<AlpakaIdxSize>(1u)), KERNEL\
         PMACC_KERNEL_PARAMS
+
+/**
+ * Calls a kernel written for the element layer (see PMACC_KERNEL_ELEMENT_LAYER)
+ * and creates an EventTask which represents the kernel.
+ *
+ * @param KERNEL Instance of the kernel.
+ */
+#define __cudaKernelElements(KERNEL, DIM, ...)\
+    {\
+        PMACC_KERNEL_CATCH(::PMacc::Environment<>::get().StreamController().waitForAll(), "__cudaKernelElements: crash before kernel call");\
+        ::PMacc::TaskKernel * const taskKernel(::PMacc::Environment<>::get().Factory().createTaskKernel(#KERNEL));\
+        auto const exec(::alpaka::exec::create<::PMacc::AlpakaAccElements<DIM>>(::PMacc::getWorkDivElements<DIM>(__VA_ARGS__), KERNEL\
+        PMACC_KERNEL_PARAMS
@@ -96,6 +96,22 @@ namespace PMacc
             isActivated=true;
         }
 
+        /**
+         * Wait until all work enqueued into the EventStreams is finished.
+         *
+         * Waiting for the accelerator device is not sufficient for
+         * asynchronous CPU streams because the CPU device does not track
+         * the streams created on it.
+         */
+        void waitForAll()
+        {
+            for (auto & stream : streams)
+            {
+                alpaka::wait::wait(stream->getCudaStream());
+            }
+            alpaka::wait::wait(*device.get());
+        }
+
         /**
          * Returns the number of available EventStreams in the queue.
          * @return number of EventStreams
@@ -0,0 +1,143 @@
+/**
+ * Copyright 2026 agent
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "communication/manager_common.h"
+#include "communication/ICommunicator.hpp"
+#include "eventSystem/EventSystem.hpp"
+#include "eventSystem/tasks/MPITask.hpp"
+#include "mappings/simulation/EnvironmentController.hpp"
+#include "memory/dataTypes/Mask.hpp"
+
+#include <mpi.h>
+
+namespace PMacc
+{
+
+    /** receive the halos of all buffers of a CommunicationGroup from one neighbor
+     *
+     * One message is received, unpacked into the receive exchanges of all
+     * buffers and copied to the device.
+     *
+     * @tparam T_Group CommunicationGroup
+     */
+    template <class T_Group>
+    class TaskReceiveGroup : public MPITask
+    {
+    public:
+
+        TaskReceiveGroup(T_Group &group, uint32_t exchange) :
+        group(&group),
+        exchange(exchange),
+        request(NULL),
+        state(Constructor)
+        {
+        }
+
+        virtual void init()
+        {
+            state = WaitForReceived;
+            __startAtomicTransaction();
+            request = Environment<T_Group::Dim>::get().EnvironmentController()
+                .getCommunicator().startReceive(
+                                                exchange,
+                                                group->getReceiveMessage(exchange),
+                                                group->getMaxReceiveBytes(exchange),
+                                                group->getCommunicationTag(Mask::getMirroredExchangeType(exchange)));
+            __endTransaction();
+        }
+
+        bool executeIntern()
+        {
+            switch (state)
+            {
+                case WaitForReceived:
+                {
+                    ICommunicator& communicator = Environment<T_Group::Dim>::get().EnvironmentController()
+                        .getCommunicator();
+                    if (communicator.testRequest(request, &status))
+                    {
+                        communicator.releaseRequest(request);
+                        request = NULL;
+
+                        int bytes;
+                        MPI_CHECK(MPI_Get_count(&status, MPI_CHAR, &bytes));
+                        group->unpackReceive(exchange, bytes);
+
+                        state = WaitForCopy;
+                        __startAtomicTransaction();
+                        copyEvent = group->copyReceiveToDevice(exchange);
+                        __endTransaction();
+                    }
+                    break;
+                }
+                case WaitForCopy:
+                    if (NULL == Environment<>::get().Manager().getITaskIfNotFinished(copyEvent.getTaskId()))
+                    {
+                        state = Finish;
+                        return true;
+                    }
+                    break;
+                case Finish:
+                    return true;
+                default:
+                    return false;
+            }
+
+            return false;
+        }
+
+        virtual ~TaskReceiveGroup()
+        {
+            notify(this->myId, RECVFINISHED, NULL);
+        }
+
+        void event(id_t, EventType, IEventData*)
+        {
+        }
+
+        std::string toString()
+        {
+            return "TaskReceiveGroup";
+        }
+
+    private:
+
+        enum state_t
+        {
+            Constructor,
+            WaitForReceived,
+            WaitForCopy,
+            Finish
+        };
+
+        T_Group *group;
+        uint32_t exchange;
+        EventTask copyEvent;
+        MPI_Request *request;
+        MPI_Status status;
+        state_t state;
+    };
+
+} //namespace PMacc
@@ -0,0 +1,85 @@
+/**
+ * Copyright 2026 agent
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "eventSystem/tasks/MPITask.hpp"
+#include "mpi/ReduceFuture.hpp"
+
+#include <mpi.h>
+
+namespace PMacc
+{
+
+    /** progress a non-blocking reduce while the event system is executed
+     *
+     * The task is finished if the reduce of the future is finished,
+     * \see mpi::MPIReduce::startReduce
+     */
+    template<typename T_Type>
+    class TaskReduceMPI : public MPITask
+    {
+    public:
+
+        TaskReduceMPI(const mpi::ReduceFuture<T_Type>& future) :
+        MPITask(),
+        future(future)
+        {
+        }
+
+        virtual void init()
+        {
+        }
+
+        bool executeIntern()
+        {
+            if (this->isFinished())
+                return true;
+
+            if (future.isFinished())
+            {
+                this->setFinished();
+                return true;
+            }
+            return false;
+        }
+
+        virtual ~TaskReduceMPI()
+        {
+            notify(this->myId, RECVFINISHED, NULL);
+        }
+
+        void event(id_t, EventType, IEventData*)
+        {
+        }
+
+        std::string toString()
+        {
+            return "TaskReduceMPI";
+        }
+
+    private:
+        mpi::ReduceFuture<T_Type> future;
+    };
+
+} //namespace PMacc
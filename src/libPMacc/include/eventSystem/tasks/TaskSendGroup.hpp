@@ -0,0 +1,147 @@
+/**
+ * Copyright 2026 agent
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "communication/manager_common.h"
+#include "communication/ICommunicator.hpp"
+#include "eventSystem/EventSystem.hpp"
+#include "eventSystem/tasks/MPITask.hpp"
+#include "mappings/simulation/EnvironmentController.hpp"
+
+#include <mpi.h>
+
+namespace PMacc
+{
+
+    /** send the halos of all buffers of a CommunicationGroup to one neighbor
+     *
+     * The send exchanges of all buffers are copied to the host, packed into
+     * one message and sent with a single MPI call.
+     *
+     * @tparam T_Group CommunicationGroup
+     */
+    template <class T_Group>
+    class TaskSendGroup : public MPITask
+    {
+    public:
+
+        TaskSendGroup(T_Group &group, uint32_t exchange) :
+        group(&group),
+        exchange(exchange),
+        request(NULL),
+        state(Constructor)
+        {
+        }
+
+        virtual void init()
+        {
+            __startTransaction();
+            state = WaitForCopy;
+            copyEvent = group->copySendToHost(exchange);
+            __endTransaction(); //we need no blocking because we poll the copy event
+        }
+
+        bool executeIntern()
+        {
+            switch (state)
+            {
+                case WaitForCopy:
+                    if (NULL == Environment<>::get().Manager().getITaskIfNotFinished(copyEvent.getTaskId()))
+                    {
+                        const size_t bytes = group->packSend(exchange);
+                        state = WaitForSend;
+                        __startTransaction();
+                        request = Environment<T_Group::Dim>::get().EnvironmentController()
+                            .getCommunicator().startSend(
+                                                         exchange,
+                                                         group->getSendMessage(exchange),
+                                                         bytes,
+                                                         group->getCommunicationTag(exchange));
+                        __endTransaction();
+                    }
+                    break;
+                case WaitForSend:
+                {
+                    ICommunicator& communicator = Environment<T_Group::Dim>::get().EnvironmentController()
+                        .getCommunicator();
+                    if (communicator.testRequest(request, &status))
+                    {
+                        communicator.releaseRequest(request);
+                        request = NULL;
+                        state = Finish;
+                        return true;
+                    }
+                    break;
+                }
+                case Finish:
+                    return true;
+                default:
+                    return false;
+            }
+
+            return false;
+        }
+
+        /** event of the copy of the send data to the host
+         *
+         * Valid after init(), i.e. after the task is started.
+         */
+        EventTask getCopyEvent() const
+        {
+            return copyEvent;
+        }
+
+        virtual ~TaskSendGroup()
+        {
+            notify(this->myId, SENDFINISHED, NULL);
+        }
+
+        void event(id_t, EventType, IEventData*)
+        {
+        }
+
+        std::string toString()
+        {
+            return "TaskSendGroup";
+        }
+
+    private:
+
+        enum state_t
+        {
+            Constructor,
+            WaitForCopy,
+            WaitForSend,
+            Finish
+        };
+
+        T_Group *group;
+        uint32_t exchange;
+        EventTask copyEvent;
+        MPI_Request *request;
+        MPI_Status status;
+        state_t state;
+    };
+
+} //namespace PMacc
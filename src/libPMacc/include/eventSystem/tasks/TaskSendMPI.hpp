@@ -65,12 +65,11 @@ public:
         if (this->request == NULL)
             throw std::runtime_error("request was NULL (call executeIntern after freed");
 
-        int flag=0;
-        MPI_CHECK(MPI_Test(this->request, &flag, &(this->status)));
+        ICommunicator& communicator = Environment<DIM>::get().EnvironmentController().getCommunicator();
 
-        if (flag) //finished
+        if (communicator.testRequest(this->request, &(this->status))) //finished
         {
-            delete this->request;
+            communicator.releaseRequest(this->request);
             this->request = NULL;
             this->setFinished();
             return true;
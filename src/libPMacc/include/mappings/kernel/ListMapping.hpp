@@ -0,0 +1,260 @@
+/**
+ * Copyright 2026 agent
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "types.h"
+#include "dimensions/DataSpace.hpp"
+#include "dimensions/DataSpaceOperations.hpp"
+
+namespace PMacc
+{
+
+/** partition supercells into colors
+ *
+ * Two supercells of the same color have a distance of at least stride
+ * supercells in every dimension (same as the domains of StrideMapping).
+ *
+ * @tparam DIM dimension of the grid
+ * @tparam stride distance between two supercells of the same color
+ */
+template<unsigned DIM, uint32_t stride>
+struct StrideColoring
+{
+    static constexpr uint32_t numColors =
+        DIM == DIM1 ? stride : (DIM == DIM2 ? stride * stride : stride * stride * stride);
+
+    /** color of a supercell */
+    HDINLINE static uint32_t getColor(const DataSpace<DIM>& superCellIdx)
+    {
+        DataSpace<DIM> colorIdx;
+        for (uint32_t d = 0; d < DIM; ++d)
+            colorIdx[d] = superCellIdx[d] % (int)stride;
+        return DataSpaceOperations<DIM>::map(DataSpace<DIM>::create(stride), colorIdx);
+    }
+
+    /** number of supercells of a color
+     *
+     * @param gridSuperCells number of supercells in the grid
+     */
+    HDINLINE static uint32_t getSize(uint32_t color, const DataSpace<DIM>& gridSuperCells)
+    {
+        const DataSpace<DIM> colorIdx(DataSpaceOperations<DIM>::map(DataSpace<DIM>::create(stride), (int)color));
+        uint32_t size = 1;
+        for (uint32_t d = 0; d < DIM; ++d)
+            size *= (gridSuperCells[d] - colorIdx[d] + (int)stride - 1) / (int)stride;
+        return size;
+    }
+
+    /** number of supercells of all colors before color */
+    HDINLINE static uint32_t getOffset(uint32_t color, const DataSpace<DIM>& gridSuperCells)
+    {
+        uint32_t offset = 0;
+        for (uint32_t c = 0; c < color; ++c)
+            offset += getSize(c, gridSuperCells);
+        return offset;
+    }
+};
+
+template<class baseClass>
+class ListMapping;
+
+/** mapping over a list of supercells
+ *
+ * The list can be split into partitions (e.g. the colors of StrideColoring)
+ * which are walked with next() like the domains of StrideMapping.
+ *
+ * If the size of a list is known on the host, block i of a kernel is mapped
+ * to the i-th supercell of the list. The size can also be known on the
+ * device only (it is written by a kernel), the grid is then an estimate of
+ * the size and block i handles the entries i, i + grid size, ... below the
+ * size on the device. Kernels walk over their supercells with
+ * forEachMappedSuperCell().
+ */
+template<
+template<unsigned, class> class baseClass,
+unsigned DIM,
+class SuperCellSize_
+>
+class ListMapping<baseClass<DIM, SuperCellSize_> > : public baseClass<DIM, SuperCellSize_>
+{
+public:
+    typedef baseClass<DIM, SuperCellSize_> BaseClass;
+
+    enum
+    {
+        AreaType = CORE + BORDER, Dim = BaseClass::Dim
+    };
+
+
+    typedef typename BaseClass::SuperCellSize SuperCellSize;
+
+    /**
+     * @param superCells device pointer to the list of supercell indices
+     * @param gridSize number of blocks, the size of the list if deviceSize is NULL
+     * @param deviceSize device pointer to the size of the list, NULL if the size is gridSize
+     * @param sizeOffset added to *deviceSize (e.g. the counter covers only a part of the list)
+     */
+    HINLINE ListMapping(BaseClass base, const DataSpace<DIM>* superCells, uint32_t gridSize,
+                        const uint32_t* deviceSize = NULL, int32_t sizeOffset = 0) :
+    BaseClass(base), listBase(superCells), list(superCells), listGridSize(gridSize),
+    listDeviceSize(deviceSize), listSizeOffset(sizeOffset),
+    partitionOffsets(NULL), partitionGridSizes(NULL), partitionDeviceSizes(NULL),
+    numPartitions(1), partition(0)
+    {
+    }
+
+    /**
+     * @param superCells device pointer to the list of supercell indices
+     * @param offsets host array with the offset of each partition in the list
+     * @param gridSizes host array with the number of blocks for each partition
+     * @param deviceSizes device array with the number of supercells in each
+     *                    partition, NULL if the sizes are gridSizes
+     * @param partitions number of partitions
+     */
+    HINLINE ListMapping(BaseClass base, const DataSpace<DIM>* superCells,
+                        const uint32_t* offsets, const uint32_t* gridSizes,
+                        const uint32_t* deviceSizes, uint32_t partitions) :
+    BaseClass(base), listBase(superCells), list(superCells + offsets[0]), listGridSize(gridSizes[0]),
+    listDeviceSize(deviceSizes), listSizeOffset(0),
+    partitionOffsets(offsets), partitionGridSizes(gridSizes), partitionDeviceSizes(deviceSizes),
+    numPartitions(partitions), partition(0)
+    {
+    }
+
+    /**
+     * Generate grid dimension information for kernel calls
+     *
+     * @return size of the grid
+     */
+    HINLINE DataSpace<DIM> getGridDim() const
+    {
+        DataSpace<DIM> gridDim(DataSpace<DIM>::create(1));
+        gridDim.x() = getListGridSize();
+        return gridDim;
+    }
+
+    /**
+     * Returns index of current logical block
+     *
+     * @param realSuperCellIdx current SuperCell index (block index)
+     * @return mapped SuperCell index
+     */
+    HDINLINE DataSpace<DIM> getSuperCellIndex(const DataSpace<DIM>& realSuperCellIdx) const
+    {
+        return list[realSuperCellIdx.x()];
+    }
+
+    /** supercell index of a list entry */
+    HDINLINE DataSpace<DIM> getListEntry(uint32_t idx) const
+    {
+        return list[idx];
+    }
+
+    /** number of supercells in the list */
+    HDINLINE uint32_t getListSize() const
+    {
+        if (listDeviceSize == NULL)
+            return listGridSize;
+        return static_cast<uint32_t>(static_cast<int32_t>(*listDeviceSize) + listSizeOffset);
+    }
+
+    /** number of blocks of the grid
+     *
+     * An empty list is launched with one block, there is no kernel launch
+     * with an empty grid.
+     */
+    HDINLINE uint32_t getListGridSize() const
+    {
+        return listGridSize == 0 ? 1u : listGridSize;
+    }
+
+    /** set mapper to the next partition
+     *
+     * @return true if partition is valid, else false
+     */
+    HINLINE bool next()
+    {
+        if (partition + 1 >= numPartitions)
+            return false;
+        ++partition;
+        list = listBase + partitionOffsets[partition];
+        listGridSize = partitionGridSizes[partition];
+        listDeviceSize = partitionDeviceSizes == NULL ? NULL : partitionDeviceSizes + partition;
+        return true;
+    }
+
+private:
+    PMACC_ALIGN(listBase, const DataSpace<DIM>*);
+    PMACC_ALIGN(list, const DataSpace<DIM>*);
+    PMACC_ALIGN(listGridSize, uint32_t);
+    PMACC_ALIGN(listDeviceSize, const uint32_t*);
+    PMACC_ALIGN(listSizeOffset, int32_t);
+    /* host side only */
+    PMACC_ALIGN(partitionOffsets, const uint32_t*);
+    PMACC_ALIGN(partitionGridSizes, const uint32_t*);
+    PMACC_ALIGN(partitionDeviceSizes, const uint32_t*);
+    PMACC_ALIGN(numPartitions, uint32_t);
+    PMACC_ALIGN(partition, uint32_t);
+
+};
+
+/** call functor(superCellIdx) for each supercell mapped to a block
+ *
+ * Each block of a mapping is mapped to one supercell.
+ * Shared memory of a kernel must be allocated before this call,
+ * \see forEachMappedSuperCell() for ListMapping.
+ *
+ * @param blockIdx index of the block in the grid
+ */
+template<typename T_Acc, class T_Mapping, typename T_Functor>
+DINLINE void forEachMappedSuperCell(T_Acc const &, const T_Mapping& mapper,
+                                    const DataSpace<T_Mapping::Dim>& blockIdx, T_Functor functor)
+{
+    functor(mapper.getSuperCellIndex(blockIdx));
+}
+
+/** call functor(superCellIdx) for each list entry of a block
+ *
+ * The block is synchronized after each supercell, the functor may return
+ * early if all threads of the block do so.
+ */
+template<
+typename T_Acc,
+template<unsigned, class> class baseClass,
+unsigned DIM,
+class SuperCellSize_,
+typename T_Functor
+>
+DINLINE void forEachMappedSuperCell(T_Acc const & acc, const ListMapping<baseClass<DIM, SuperCellSize_> >& mapper,
+                                    const DataSpace<DIM>& blockIdx, T_Functor functor)
+{
+    const uint32_t listSize = mapper.getListSize();
+    for (uint32_t i = blockIdx.x(); i < listSize; i += mapper.getListGridSize())
+    {
+        functor(mapper.getListEntry(i));
+        alpaka::block::sync::syncBlockThreads(acc);
+    }
+}
+
+} // namespace PMacc
@@ -27,8 +27,11 @@
 #include "dimensions/DataSpaceOperations.hpp"
 #include "mappings/simulation/EnvironmentController.hpp"
 #include "communication/CommunicatorMPI.hpp"
+#include "communication/CommunicatorNeighborMPI.hpp"
 #include "mappings/simulation/SubGrid.hpp"
 
+#include <memory>
+
 namespace PMacc
 {
 
@@ -171,7 +174,7 @@ namespace PMacc
                /* wait that all tasks are finished */
                Environment<DIM>::get().Manager().waitForAllTasks();//
 
-               bool result = comm.slide();
+               bool result = Environment<DIM>::get().EnvironmentController().getCommunicator().slide();
 
                updateLocalDomainOffset();
 
@@ -193,7 +196,7 @@ namespace PMacc
              */
             bool setStateAfterSlides(size_t numSlides)
             {
-                bool result = comm.setStateAfterSlides(numSlides);
+                bool result = Environment<DIM>::get().EnvironmentController().getCommunicator().setStateAfterSlides(numSlides);
                 updateLocalDomainOffset();
                 return result;
             }
@@ -208,6 +211,22 @@ namespace PMacc
                 return Environment<DIM>::get().EnvironmentController().getCommunicationMask();
             }
 
+            /**
+             * Exchanges all directions of an exchange with MPI-3 neighborhood
+             * collectives instead of point-to-point messages.
+             *
+             * Must be called after init() and before any exchange is added to a buffer.
+             */
+            void useNeighborCollectives()
+            {
+#if (MPI_VERSION >= 3)
+                neighborComm.reset(new CommunicatorNeighborMPI<DIM>(comm));
+                Environment<DIM>::get().EnvironmentController().setCommunicator(*neighborComm);
+#else
+                throw std::runtime_error("neighborhood collectives need MPI-3");
+#endif
+            }
+
             /**
              * Returns the MPI communicator class
              *
@@ -278,6 +297,10 @@ namespace PMacc
              * Communicator for MPI
              */
             static CommunicatorMPI<DIM> comm;
+#if (MPI_VERSION >= 3)
+            //! communicator with neighborhood collectives \see useNeighborCollectives
+            std::unique_ptr<CommunicatorNeighborMPI<DIM> > neighborComm;
+#endif
 
             /**
              * number of GPU nodes for each direction
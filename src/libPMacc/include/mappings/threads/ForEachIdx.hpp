@@ -0,0 +1,99 @@
+/**
+ * Copyright 2026 agent
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "dimensions/DataSpaceOperations.hpp"
+#include "dimensions/DataSpace.hpp"
+#include "types.h"
+
+#include <utility>
+
+namespace PMacc
+{
+
+/** iterate over all virtual threads (cells) of a block owned by this thread
+ *
+ * A kernel started with __cudaKernelElements or __picKernelAreaElements must
+ * not assume one alpaka thread per cell. Depending on
+ * PMACC_KERNEL_ELEMENT_LAYER one thread represents one cell or all cells of
+ * the block (mapped to the alpaka element layer).
+ * The functor is called with the linear index of each virtual thread.
+ * The loop contains no barrier and therefore can be vectorized.
+ *
+ * @tparam BlockSize_ compile time vector with the size of a block in cells,
+ *                    the last dimension can be a multiple of it
+ */
+template<class BlockSize_>
+class ForEachIdx
+{
+private:
+
+    enum
+    {
+        Dim = BlockSize_::dim
+    };
+
+public:
+
+    template<typename T_Acc>
+    DINLINE ForEachIdx(T_Acc const & acc) :
+    numElements(
+        DataSpace<Dim>(alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>(acc)).productOfComponents()),
+    beginIdx(
+        DataSpaceOperations<Dim>::template map<BlockSize_>(
+            DataSpace<Dim>(alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc))) * numElements)
+    {
+    }
+
+    template<class F>
+    DINLINE void operator()(F && f) const
+    {
+        for (int i = 0; i < numElements; ++i)
+        {
+            std::forward<F>(f)(beginIdx + i);
+        }
+    }
+
+    /** linear index of the first virtual thread handled by this thread
+     *
+     * The virtual threads of this thread are [begin(), begin() + size()).
+     */
+    DINLINE int begin() const
+    {
+        return beginIdx;
+    }
+
+    /** number of virtual threads handled by this thread */
+    DINLINE int size() const
+    {
+        return numElements;
+    }
+
+private:
+    PMACC_ALIGN(numElements, int const);
+    PMACC_ALIGN(beginIdx, int const);
+
+};
+
+}//namespace
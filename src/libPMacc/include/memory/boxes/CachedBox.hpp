@@ -57,6 +57,13 @@ namespace PMacc
                 return c_box.shift(offset);
             }
 
+            HDINLINE static Type create(ValueType* memory)
+            {
+                DataSpace<OffsetOrigin::dim> offset(OffsetOrigin::toRT());
+                Type c_box(SharedBox<ValueType, FullSuperCellSize, T_Id>(memory));
+                return c_box.shift(offset);
+            }
+
         };
     }
 
@@ -88,6 +95,21 @@ namespace PMacc
             return intern::CachedBox<ValueType_, BlockDescription_, Id_>::create(acc);
         }
 
+        /** create a cache on already allocated memory (e.g. thread private)
+         *
+         * @param memory pointer to volume of BlockDescription_::FullSuperCellSize elements
+         */
+        template<
+            uint32_t Id_,
+            typename ValueType_,
+            class BlockDescription_>
+        HDINLINE static typename intern::CachedBox<ValueType_, BlockDescription_, Id_ >::Type create(
+            ValueType_* memory,
+            const BlockDescription_ block)
+        {
+            return intern::CachedBox<ValueType_, BlockDescription_, Id_>::create(memory);
+        }
+
     };
 
 }
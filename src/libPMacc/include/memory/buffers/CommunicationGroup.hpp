@@ -0,0 +1,401 @@
+/**
+ * Copyright 2026 agent
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "eventSystem/EventSystem.hpp"
+#include "eventSystem/tasks/TaskSendGroup.hpp"
+#include "eventSystem/tasks/TaskReceiveGroup.hpp"
+#include "memory/buffers/GridBuffer.hpp"
+#include "memory/dataTypes/Mask.hpp"
+#include "traits/NumberOfExchanges.hpp"
+
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <stdexcept>
+#include <sstream>
+
+namespace PMacc
+{
+namespace communicationGroup
+{
+
+/** type independent access to the exchanges of one GridBuffer of a group */
+class IMember
+{
+public:
+
+    virtual ~IMember()
+    {
+    }
+
+    virtual bool hasSendExchange(uint32_t ex) const = 0;
+    virtual bool hasReceiveExchange(uint32_t ex) const = 0;
+
+    /** start the copy of the send exchange to its host buffer */
+    virtual EventTask copySendToHost(uint32_t ex) = 0;
+    virtual size_t getSendBytes(uint32_t ex) const = 0;
+    virtual const char* getSendPointer(uint32_t ex) const = 0;
+
+    virtual size_t getMaxReceiveBytes(uint32_t ex) const = 0;
+    virtual char* getReceivePointer(uint32_t ex) = 0;
+    virtual void setReceiveBytes(uint32_t ex, size_t bytes) = 0;
+    /** start the copy of the receive exchange from its host buffer to the GridBuffer */
+    virtual EventTask copyReceiveToDevice(uint32_t ex) = 0;
+};
+
+/** member of a group
+ *
+ * @tparam T_GetBuffer functor which returns the GridBuffer, it is called
+ *                     for each access because a buffer can be swapped
+ *                     (e.g. with a back buffer of a field solver)
+ */
+template<class T_GetBuffer>
+class Member : public IMember
+{
+public:
+
+    Member(T_GetBuffer getBuffer) : getBuffer(getBuffer)
+    {
+    }
+
+    bool hasSendExchange(uint32_t ex) const
+    {
+        return getBuffer().hasSendExchange(ex);
+    }
+
+    bool hasReceiveExchange(uint32_t ex) const
+    {
+        return getBuffer().hasReceiveExchange(ex);
+    }
+
+    EventTask copySendToHost(uint32_t ex)
+    {
+        if (!hasSendExchange(ex))
+            return EventTask();
+
+        auto& exchange = getBuffer().getSendExchange(ex);
+        if (exchange.hasDeviceDoubleBuffer())
+        {
+            Environment<>::get().Factory().createTaskCopyDeviceToDevice(exchange.getDeviceBuffer(),
+                                                                         exchange.getDeviceDoubleBuffer());
+            return Environment<>::get().Factory().createTaskCopyDeviceToHost(exchange.getDeviceDoubleBuffer(),
+                                                                              exchange.getHostBuffer());
+        }
+        return Environment<>::get().Factory().createTaskCopyDeviceToHost(exchange.getDeviceBuffer(),
+                                                                          exchange.getHostBuffer());
+    }
+
+    size_t getSendBytes(uint32_t ex) const
+    {
+        if (!hasSendExchange(ex))
+            return 0;
+        auto& hostBuffer = getBuffer().getSendExchange(ex).getHostBuffer();
+        return hostBuffer.getCurrentSize() * sizeof (*hostBuffer.getBasePointer());
+    }
+
+    const char* getSendPointer(uint32_t ex) const
+    {
+        return (const char*) getBuffer().getSendExchange(ex).getHostBuffer().getPointer();
+    }
+
+    size_t getMaxReceiveBytes(uint32_t ex) const
+    {
+        if (!hasReceiveExchange(ex))
+            return 0;
+        auto& hostBuffer = getBuffer().getReceiveExchange(ex).getHostBuffer();
+        return hostBuffer.getDataSpace().productOfComponents() * sizeof (*hostBuffer.getBasePointer());
+    }
+
+    char* getReceivePointer(uint32_t ex)
+    {
+        return (char*) getBuffer().getReceiveExchange(ex).getHostBuffer().getBasePointer();
+    }
+
+    void setReceiveBytes(uint32_t ex, size_t bytes)
+    {
+        auto& hostBuffer = getBuffer().getReceiveExchange(ex).getHostBuffer();
+        hostBuffer.setCurrentSize(bytes / sizeof (*hostBuffer.getBasePointer()));
+    }
+
+    EventTask copyReceiveToDevice(uint32_t ex)
+    {
+        if (!hasReceiveExchange(ex))
+            return EventTask();
+
+        auto& exchange = getBuffer().getReceiveExchange(ex);
+        if (exchange.hasDeviceDoubleBuffer())
+        {
+            Environment<>::get().Factory().createTaskCopyHostToDevice(exchange.getHostBuffer(),
+                                                                       exchange.getDeviceDoubleBuffer());
+            return Environment<>::get().Factory().createTaskCopyDeviceToDevice(exchange.getDeviceDoubleBuffer(),
+                                                                                exchange.getDeviceBuffer());
+        }
+        return Environment<>::get().Factory().createTaskCopyHostToDevice(exchange.getHostBuffer(),
+                                                                          exchange.getDeviceBuffer());
+    }
+
+private:
+    T_GetBuffer getBuffer;
+};
+
+/** functor for a GridBuffer which is never swapped */
+template<class T_Buffer>
+struct FixedBuffer
+{
+    T_Buffer* buffer;
+
+    T_Buffer& operator()() const
+    {
+        return *buffer;
+    }
+};
+
+} //namespace communicationGroup
+
+/**
+ * Exchanges the halos of several GridBuffers with one message per neighbor.
+ *
+ * The halos of all buffers bound for the same neighbor are copied to the
+ * host, packed into one contiguous message and unpacked into the receive
+ * exchanges of the buffers on the other side. Each message starts with the
+ * size of each packed halo in bytes.
+ * The buffers keep their own exchanges (added with GridBuffer::addExchange),
+ * the group only replaces GridBuffer::asyncCommunication().
+ *
+ * @tparam DIM dimension of the buffers
+ */
+template<unsigned DIM>
+class CommunicationGroup
+{
+public:
+
+    static constexpr unsigned Dim = DIM;
+    static constexpr uint32_t Exchanges = traits::NumberOfExchanges<DIM>::value;
+
+    /**
+     * @param communicationTag tag of the group, must not be used by any GridBuffer
+     */
+    CommunicationGroup(uint32_t communicationTag) : communicationTag(communicationTag)
+    {
+        for (uint32_t ex = 1; ex < Exchanges; ++ex)
+        {
+            if (!privateGridBuffer::UniquTag::getInstance().isTagUniqu(getCommunicationTag(ex)))
+            {
+                std::stringstream message;
+                message << "unique exchange communication tag ("
+                    << getCommunicationTag(ex) << ") witch is created from communicationTag ("
+                    << communicationTag << ") allready used for other gridbuffer exchange";
+                throw std::runtime_error(message.str());
+            }
+            Environment<>::get().EnvironmentController().getCommunicator().registerExchangeTag(getCommunicationTag(ex));
+        }
+    }
+
+    /** add a GridBuffer to the group */
+    template<class TYPE, class BORDERTYPE>
+    void add(GridBuffer<TYPE, DIM, BORDERTYPE>& buffer)
+    {
+        communicationGroup::FixedBuffer<GridBuffer<TYPE, DIM, BORDERTYPE> > getBuffer;
+        getBuffer.buffer = &buffer;
+        addMember(getBuffer);
+    }
+
+    /** add a GridBuffer which is returned by a functor
+     *
+     * @param getBuffer functor without arguments which returns a GridBuffer&
+     */
+    template<class T_GetBuffer>
+    void addMember(T_GetBuffer getBuffer)
+    {
+        members.push_back(std::unique_ptr<communicationGroup::IMember>(
+            new communicationGroup::Member<T_GetBuffer>(getBuffer)));
+    }
+
+    /**
+     * Starts sync data from the device buffers of all members to the neighbors.
+     * This operation runs sequential to other code but intern asynchronous
+     */
+    EventTask communication()
+    {
+        EventTask ev = this->asyncCommunication(__getTransactionEvent());
+        __setTransactionEvent(ev);
+        return ev;
+    }
+
+    /**
+     * Starts sync data from the device buffers of all members to the neighbors.
+     *
+     * @return event of the receive and of the copy of the send data, all
+     *         work on the device can run after the data is copied
+     */
+    EventTask asyncCommunication(EventTask serialEvent)
+    {
+        EventTask evR;
+        for (uint32_t i = 1; i < Exchanges; ++i)
+        {
+            if (hasReceiveExchange(i))
+            {
+                __startAtomicTransaction(serialEvent + receiveEvents[i]);
+                receiveEvents[i] = Environment<>::get().Factory().startTask(
+                    *(new TaskReceiveGroup<CommunicationGroup>(*this, i)), NULL);
+                __endTransaction();
+                evR += receiveEvents[i];
+            }
+
+            const uint32_t sendEx = Mask::getMirroredExchangeType(i);
+            if (hasSendExchange(sendEx))
+            {
+                TaskSendGroup<CommunicationGroup>* sendTask = new TaskSendGroup<CommunicationGroup>(*this, sendEx);
+                __startAtomicTransaction(serialEvent + sendEvents[sendEx]);
+                sendEvents[sendEx] = Environment<>::get().Factory().startTask(*sendTask, NULL);
+                /* startTask() has called init() which started the copy, the task is
+                 * not executed (and deleted) before the next update of the event system */
+                const EventTask copyEvent = sendTask->getCopyEvent();
+                __endTransaction();
+                /* add only the copy event, because all work on gpu can run after data is copyed */
+                evR += copyEvent;
+            }
+        }
+        return evR;
+    }
+
+    bool hasSendExchange(uint32_t ex) const
+    {
+        for (size_t m = 0; m < members.size(); ++m)
+            if (members[m]->hasSendExchange(ex))
+                return true;
+        return false;
+    }
+
+    bool hasReceiveExchange(uint32_t ex) const
+    {
+        for (size_t m = 0; m < members.size(); ++m)
+            if (members[m]->hasReceiveExchange(ex))
+                return true;
+        return false;
+    }
+
+    /** tag of the messages sent in direction ex */
+    uint32_t getCommunicationTag(uint32_t ex) const
+    {
+        return (communicationTag << 5) | ex;
+    }
+
+    /** copy the send exchanges of all members to the host */
+    EventTask copySendToHost(uint32_t ex)
+    {
+        EventTask ev;
+        for (size_t m = 0; m < members.size(); ++m)
+            ev += members[m]->copySendToHost(ex);
+        return ev;
+    }
+
+    /** pack the send exchanges of all members into one message
+     *
+     * @return size of the message in bytes
+     */
+    size_t packSend(uint32_t ex)
+    {
+        const size_t headerBytes = members.size() * sizeof (uint64_t);
+        size_t bytes = headerBytes;
+        for (size_t m = 0; m < members.size(); ++m)
+            bytes += members[m]->getSendBytes(ex);
+        sendMessages[ex].resize(bytes);
+
+        char* message = &(sendMessages[ex][0]);
+        size_t offset = headerBytes;
+        for (size_t m = 0; m < members.size(); ++m)
+        {
+            const uint64_t memberBytes = members[m]->getSendBytes(ex);
+            std::memcpy(message + m * sizeof (uint64_t), &memberBytes, sizeof (uint64_t));
+            if (memberBytes != 0)
+                std::memcpy(message + offset, members[m]->getSendPointer(ex), memberBytes);
+            offset += memberBytes;
+        }
+        return bytes;
+    }
+
+    char* getSendMessage(uint32_t ex)
+    {
+        return &(sendMessages[ex][0]);
+    }
+
+    size_t getMaxReceiveBytes(uint32_t ex)
+    {
+        size_t bytes = members.size() * sizeof (uint64_t);
+        for (size_t m = 0; m < members.size(); ++m)
+            bytes += members[m]->getMaxReceiveBytes(ex);
+        receiveMessages[ex].resize(bytes);
+        return bytes;
+    }
+
+    char* getReceiveMessage(uint32_t ex)
+    {
+        getMaxReceiveBytes(ex);
+        return &(receiveMessages[ex][0]);
+    }
+
+    /** copy a received message into the receive exchanges of all members */
+    void unpackReceive(uint32_t ex, size_t bytes)
+    {
+        const char* message = &(receiveMessages[ex][0]);
+        size_t offset = members.size() * sizeof (uint64_t);
+        for (size_t m = 0; m < members.size(); ++m)
+        {
+            uint64_t memberBytes;
+            std::memcpy(&memberBytes, message + m * sizeof (uint64_t), sizeof (uint64_t));
+            if (offset + memberBytes > bytes || memberBytes > members[m]->getMaxReceiveBytes(ex))
+                throw std::runtime_error("CommunicationGroup: received message does not fit the receive exchanges");
+            if (members[m]->hasReceiveExchange(ex))
+            {
+                if (memberBytes != 0)
+                    std::memcpy(members[m]->getReceivePointer(ex), message + offset, memberBytes);
+                members[m]->setReceiveBytes(ex, memberBytes);
+            }
+            offset += memberBytes;
+        }
+    }
+
+    /** copy the receive exchanges of all members to the device */
+    EventTask copyReceiveToDevice(uint32_t ex)
+    {
+        EventTask ev;
+        for (size_t m = 0; m < members.size(); ++m)
+            ev += members[m]->copyReceiveToDevice(ex);
+        return ev;
+    }
+
+private:
+
+    uint32_t communicationTag;
+    std::vector<std::unique_ptr<communicationGroup::IMember> > members;
+
+    /* host messages, one per direction */
+    std::vector<char> sendMessages[27];
+    std::vector<char> receiveMessages[27];
+    EventTask sendEvents[27];
+    EventTask receiveEvents[27];
+};
+
+} //namespace PMacc
@@ -100,7 +100,7 @@ public:
         __startOperation(ITask::TASK_CUDA);
         if (!preserveData)
         {
-            AlpakaAccStream stream(Environment<>::get().DeviceManager().getAccDevice());
+            AlpakaAccStreamSync stream(Environment<>::get().DeviceManager().getAccDevice());
             alpaka::mem::view::set(
                 stream,
                 m_dataViewDev,
@@ -237,6 +237,7 @@ public:
                     throw std::runtime_error(message.str());
                 }
                 hasOneExchange = true;
+                Environment<DIM>::get().EnvironmentController().getCommunicator().registerExchangeTag(uniqCommunicationTag);
 
                 if (sendExchanges[ex] != NULL)
                 {
@@ -307,6 +308,7 @@ public:
                         throw std::runtime_error(message.str());
                     }
                     hasOneExchange = true;
+                    Environment<DIM>::get().EnvironmentController().getCommunicator().registerExchangeTag(uniqCommunicationTag);
 
                     if (sendExchanges[ex] != NULL)
                     {
@@ -331,6 +333,57 @@ public:
         }
     }
 
+    /**
+     * Resize a send exchange in dedicated memory space.
+     *
+     * The send exchange in ex direction (created by addExchangeBuffer) is
+     * recreated with the new size, its content is lost.
+     * The receive exchange of the neighbor must be resized to the same size.
+     * No communication of this GridBuffer is allowed to be in flight.
+     *
+     * @param ex send direction of the exchange
+     * @param dataSpace new size of the exchange buffer in each dimension
+     * @param sizeOnDevice if true, internal buffers have their size information on the device, too
+     */
+    void resizeSendExchangeBuffer(uint32_t ex, const DataSpace<DIM> &dataSpace, bool sizeOnDevice = false)
+    {
+        if (sendExchanges[ex] == NULL)
+            throw std::runtime_error("Exchange does not exist!");
+
+        const uint32_t uniqCommunicationTag = sendExchanges[ex]->getCommunicationTag();
+
+        /* free old memory first to keep the peak memory usage low */
+        sendExchanges[ex].reset();
+        sendExchanges[ex].reset(
+            new ExchangeIntern<BORDERTYPE, DIM > (
+                dataSpace,
+                ex, uniqCommunicationTag, sizeOnDevice));
+    }
+
+    /**
+     * Resize a receive exchange in dedicated memory space.
+     *
+     * Counterpart of resizeSendExchangeBuffer() for the receive exchange from
+     * ex direction.
+     *
+     * @param ex receive direction of the exchange
+     * @param dataSpace new size of the exchange buffer in each dimension
+     * @param sizeOnDevice if true, internal buffers have their size information on the device, too
+     */
+    void resizeReceiveExchangeBuffer(uint32_t ex, const DataSpace<DIM> &dataSpace, bool sizeOnDevice = false)
+    {
+        if (receiveExchanges[ex] == NULL)
+            throw std::runtime_error("Exchange does not exist!");
+
+        const uint32_t uniqCommunicationTag = receiveExchanges[ex]->getCommunicationTag();
+
+        receiveExchanges[ex].reset();
+        receiveExchanges[ex].reset(
+            new ExchangeIntern<BORDERTYPE, DIM > (
+                dataSpace,
+                ex, uniqCommunicationTag, sizeOnDevice));
+    }
+
     /**
      * Returns whether this GridBuffer has an Exchange for sending in ex direction.
      *
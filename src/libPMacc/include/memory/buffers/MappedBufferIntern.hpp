@@ -115,7 +115,7 @@ public:
         this->setCurrentSize(this->getDataSpace().productOfComponents());
         if (!preserveData)
         {
-            AlpakaAccStream stream(Environment<>::get().DeviceManager().getAccDevice());
+            AlpakaAccStreamSync stream(Environment<>::get().DeviceManager().getAccDevice());
             alpaka::mem::view::set(
                 stream,
                 m_dataBufHost,
@@ -27,6 +27,9 @@
 #include "mpi/reduceMethods/AllReduce.hpp"
 #include "mpi/GetMPI_StructAsArray.hpp"
 #include "mpi/GetMPI_Op.hpp"
+#include "mpi/ReduceFuture.hpp"
+#include "Environment.hpp"
+#include "eventSystem/tasks/TaskReduceMPI.hpp"
 
 #include "types.h"
 
@@ -175,6 +178,47 @@ struct MPIReduce
     }
 
 
+    /* Start a non-blocking reduce of elements on cpu memory
+     *
+     * The reduce is progressed by the event system without blocking the
+     * current transaction, the result is read with ReduceFuture::get().
+     * All ranks must start their reduces in the same order.
+     *
+     * @param func binary functor for reduce, \see operator()
+     * @param src pointer to the elements, copied before the call returns
+     * @param n number of elements to reduce
+     * @param method mpi method for reduce
+     *
+     * @return future of the reduced elements, call hasResult() of the future
+     *         to see if the result is valid on this rank
+     */
+    template<class Functor, typename Type, class ReduceMethod >
+    HINLINE ReduceFuture<Type> startReduce(Functor func,
+                                           const Type* src,
+                                           const size_t n,
+                                           const ReduceMethod method)
+    {
+        typedef Type ValueType;
+
+        ReduceFuture<Type> future(src, n, this->hasResult(method));
+
+        method.start(func,
+                     future.getDestinationPointer(),
+                     future.getSourcePointer(),
+                     n * ::PMacc::mpi::getMPI_StructAsArray<ValueType > ().sizeMultiplier,
+                     ::PMacc::mpi::getMPI_StructAsArray<ValueType > ().dataType,
+                     ::PMacc::mpi::getMPI_Op<Functor > (),
+                     comm,
+                     future.getRequest());
+
+        /* own transaction: following tasks must not wait for the reduce */
+        __startTransaction();
+        Environment<>::get().Factory().startTask(*(new TaskReduceMPI<Type>(future)), NULL);
+        __endTransaction();
+
+        return future;
+    }
+
 private:
 
     MPI_Comm comm;
@@ -0,0 +1,168 @@
+/**
+ * Copyright 2026 agent
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "communication/manager_common.h"
+#include "types.h"
+
+#include <memory>
+#include <vector>
+#include <stdexcept>
+
+#include <mpi.h>
+
+namespace PMacc
+{
+namespace mpi
+{
+
+/** result of a non-blocking reduce, \see MPIReduce::startReduce
+ *
+ * Copies share the state of the reduce. The source and result buffers are
+ * owned by the future, the caller can reuse its source as soon as the
+ * reduce is started.
+ */
+template<typename Type>
+class ReduceFuture
+{
+public:
+
+    /** create an invalid future */
+    ReduceFuture()
+    {
+    }
+
+    /** allocate the buffers of a reduce of n elements */
+    ReduceFuture(const Type* src, const size_t n, const bool hasResult) :
+    state(new State(src, n, hasResult))
+    {
+    }
+
+    /** true if a reduce was started for this future */
+    bool isValid() const
+    {
+        return state.get() != NULL;
+    }
+
+    /** true if the result of the reduce is valid on this rank
+     *
+     * Same as MPIReduce::hasResult() with the method of the reduce.
+     */
+    bool hasResult() const
+    {
+        checkValid();
+        return state->hasResult;
+    }
+
+    /** test without blocking if the reduce is finished */
+    bool isFinished()
+    {
+        checkValid();
+        if (!state->finished)
+        {
+            int flag = 0;
+            MPI_CHECK(MPI_Test(&(state->request), &flag, MPI_STATUS_IGNORE));
+            state->finished = (flag != 0);
+        }
+        return state->finished;
+    }
+
+    /** block until the reduce is finished */
+    void waitForFinished()
+    {
+        checkValid();
+        if (!state->finished)
+        {
+            MPI_CHECK(MPI_Wait(&(state->request), MPI_STATUS_IGNORE));
+            state->finished = true;
+        }
+    }
+
+    /** reduced elements, blocks until the reduce is finished
+     *
+     * Only valid if hasResult() is true.
+     */
+    const Type* get()
+    {
+        waitForFinished();
+        return &(state->dest[0]);
+    }
+
+    /** number of reduced elements */
+    size_t size() const
+    {
+        checkValid();
+        return state->dest.size();
+    }
+
+    /** buffers for MPIReduce::startReduce */
+    Type* getSourcePointer()
+    {
+        return &(state->src[0]);
+    }
+
+    Type* getDestinationPointer()
+    {
+        return &(state->dest[0]);
+    }
+
+    MPI_Request* getRequest()
+    {
+        return &(state->request);
+    }
+
+private:
+
+    struct State
+    {
+        State(const Type* source, const size_t n, const bool hasResult) :
+        src(source, source + n), dest(n), request(MPI_REQUEST_NULL),
+        finished(false), hasResult(hasResult)
+        {
+        }
+
+        ~State()
+        {
+            /* a started reduce must finish before its buffers are freed */
+            if (!finished)
+                MPI_CHECK_NOEXCEPT(MPI_Wait(&request, MPI_STATUS_IGNORE));
+        }
+
+        std::vector<Type> src;
+        std::vector<Type> dest;
+        MPI_Request request;
+        bool finished;
+        bool hasResult;
+    };
+
+    void checkValid() const
+    {
+        if (!isValid())
+            throw std::runtime_error("ReduceFuture: no reduce was started");
+    }
+
+    std::shared_ptr<State> state;
+};
+
+} //namespace mpi
+} //namespace PMacc
@@ -51,6 +51,30 @@ struct AllReduce
                                 type,
                                 op, comm));
     }
+
+    /** start a non-blocking reduce
+     *
+     * MPI < 3 has no non-blocking collectives, the reduce is finished on
+     * return and request is MPI_REQUEST_NULL.
+     */
+    template<class Functor, typename Type >
+    HINLINE void start(Functor, Type* dest, Type* src, const size_t count, MPI_Datatype type, MPI_Op op, MPI_Comm comm, MPI_Request* request) const
+    {
+#if (MPI_VERSION >= 3)
+        MPI_CHECK(MPI_Iallreduce((void*) src,
+                                 (void*) dest,
+                                 count,
+                                 type,
+                                 op, comm, request));
+#else
+        MPI_CHECK(MPI_Allreduce((void*) src,
+                                (void*) dest,
+                                count,
+                                type,
+                                op, comm));
+        *request = MPI_REQUEST_NULL;
+#endif
+    }
 };
 
 } /*namespace reduceMethods*/
@@ -29,6 +29,14 @@
 
 #include <type_traits>
 #include <memory>
+#include <algorithm>
+#ifdef PMACC_ACC_CPU
+#   ifdef _OPENMP
+#       include <omp.h>
+#   else
+#       include <thread>
+#   endif
+#endif
 
 namespace PMacc
 {
@@ -105,6 +113,70 @@ namespace PMacc
                     func2(dest[blockIndex.x()], s_mem[0]);
                 }
             };
+#ifdef PMACC_ACC_CPU
+            /** reduce for CPU accelerators without a shared memory tree
+             *
+             * Must be started with one block, each thread of the block (an
+             * OpenMP thread of AccCpuOmp2Threads) reduces a contiguous chunk
+             * of the source into registers and stores its partial result in
+             * dest[threadIdx]. Independent accumulators break the dependency
+             * chain of the reduce thus the compiler can vectorize the loop.
+             * The partial results are combined by the host.
+             */
+            template<
+                typename T_Val>
+            struct KernelReductionCpu
+            {
+                template<
+                    typename T_Acc,
+                    typename Src,
+                    typename Dest,
+                    typename Functor>
+                ALPAKA_FN_ACC void operator()(
+                    const T_Acc& acc,
+                    const Src& src,
+                    const uint32_t& src_count,
+                    const Dest& dest,
+                    const uint32_t& chunkSize,
+                    const Functor& func) const
+                {
+                    static_assert(
+                        alpaka::dim::Dim<T_Acc>::value == 1,
+                        "The KernelReductionCpu functor has to be called with a 1 dimensional accelerator!");
+
+                    DataSpace<1> const threadIndex(alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc));
+
+                    const uint32_t begin = threadIndex.x() * chunkSize;
+                    if (begin >= src_count) return; /*end not needed threads*/
+                    const uint32_t end = std::min(begin + chunkSize, src_count);
+
+                    const uint32_t numAccumulators = 4;
+                    if (end - begin < numAccumulators)
+                    {
+                        T_Val r_value = src[begin];
+                        for (uint32_t i = begin + 1; i < end; ++i)
+                            func(r_value, src[i]);
+                        dest[threadIndex.x()] = r_value;
+                        return;
+                    }
+
+                    T_Val r_values[numAccumulators];
+                    for (uint32_t a = 0; a < numAccumulators; ++a)
+                        r_values[a] = src[begin + a];
+
+                    uint32_t i = begin + numAccumulators;
+                    for (; i + numAccumulators <= end; i += numAccumulators)
+                        for (uint32_t a = 0; a < numAccumulators; ++a)
+                            func(r_values[a], src[i + a]);
+                    for (; i < end; ++i)
+                        func(r_values[0], src[i]);
+
+                    for (uint32_t a = 1; a < numAccumulators; ++a)
+                        func(r_values[0], r_values[a]);
+                    dest[threadIndex.x()] = r_values[0];
+                }
+            };
+#endif
         }
     }
 }
@@ -183,6 +255,10 @@ namespace PMacc
                      *   thus we remove `references` and `const` qualifiers */
                     using Type = typename std::decay<typename traits::GetValueType<Src>::ValueType>::type;
 
+#ifdef PMACC_ACC_CPU
+                    return reduceCpu<Type>(func, src, n);
+#else
+
                     uint32_t blockcount = optimalThreadsPerBlock(n, sizeof (Type));
 
                     uint32_t const n_buffer = byte / sizeof (Type);
@@ -235,12 +311,55 @@ namespace PMacc
                     reduceBuffer->deviceToHost();
                     __getTransactionEvent().waitForFinished();
                     return *((Type*) (reduceBuffer->getHostBuffer().getBasePointer()));
-
+#endif
                 }
 
                 virtual ~Reduce() = default;
 
             private:
+#ifdef PMACC_ACC_CPU
+                /* one pass over the source with one chunk per CPU thread
+                 *
+                 * The partial results are read from the device buffer,
+                 * host and device share their memory on CPU accelerators.
+                 */
+                template<typename Type, class Functor, typename Src>
+                HINLINE Type reduceCpu(Functor func, Src src, uint32_t n)
+                {
+                    uint32_t threads = getCpuThreads();
+                    const uint32_t n_buffer = byte / sizeof (Type);
+                    if (threads > n_buffer) threads = n_buffer;
+                    if (threads > n) threads = n;
+                    if (threads == 0) threads = 1;
+
+                    const uint32_t chunkSize = (n + threads - 1) / threads;
+                    const uint32_t numChunks = (n + chunkSize - 1) / chunkSize;
+
+                    Type* dest = (Type*) reduceBuffer->getDeviceBuffer().getBasePointer();
+
+                    KernelReductionCpu<Type> kernel;
+                    __cudaKernel(kernel, alpaka::dim::DimInt<1u>, static_cast<AlpakaIdxSize>(1), static_cast<AlpakaIdxSize>(threads))
+                        (src, n, dest, chunkSize, func);
+                    __getTransactionEvent().waitForFinished();
+
+                    Type result = dest[0];
+                    for (uint32_t i = 1; i < numChunks; ++i)
+                        func(result, dest[i]);
+                    return result;
+                }
+
+                /* number of threads of a block on CPU accelerators */
+                HINLINE uint32_t getCpuThreads()
+                {
+#ifdef _OPENMP
+                    return static_cast<uint32_t>(omp_get_max_threads());
+#else
+                    const uint32_t threads = std::thread::hardware_concurrency();
+                    return threads == 0 ? 1 : threads;
+#endif
+                }
+#endif
+
                 /* calculate number of threads per block
                  * @param threads maximal number of threads per block
                  * @return number of threads per block
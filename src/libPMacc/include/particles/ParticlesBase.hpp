@@ -29,7 +29,8 @@
 #include "particles/memory/boxes/ParticlesBox.hpp"
 #include "particles/memory/buffers/ParticlesBuffer.hpp"
 
-#include "mappings/kernel/StrideMapping.hpp"
+#include "mappings/kernel/AreaMapping.hpp"
+#include "mappings/kernel/ListMapping.hpp"
 #include "traits/NumberOfExchanges.hpp"
 
 
@@ -60,60 +61,172 @@ public:
     static constexpr int Exchanges = traits::NumberOfExchanges<Dim>::value;
     static constexpr size_t TileSize = math::CT::volume<typename MappingDesc::SuperCellSize>::type::value;
 
+    /* Mapping over the supercells of CORE+BORDER which contain particles
+     */
+    typedef ListMapping<MappingDesc> ActiveSuperCellMapping;
+
 protected:
 
+    typedef typename BufferType::ActiveSuperCellColoring ActiveSuperCellColoring;
+
     BufferType *particlesBuffer;
 
-    ParticlesBase(MappingDesc description) : SimulationFieldHelper<MappingDesc>(description), particlesBuffer(NULL)
+    ParticlesBase(MappingDesc description) : SimulationFieldHelper<MappingDesc>(description), particlesBuffer(NULL),
+    isActiveSuperCellListValid(false), isActiveSuperCellSizeExact(false)
     {
+        const DataSpace<Dim> gridSuperCells(description.getGridSuperCells());
+        numBorderSuperCells = AreaMapping<BORDER, MappingDesc>(description).getGridDim().productOfComponents();
+        /* until the first size is known the capacities are used */
+        activeSuperCellSizes[0] = AreaMapping<CORE, MappingDesc>(description).getGridDim().productOfComponents();
+        for (uint32_t c = 0; c < ActiveSuperCellColoring::numColors; ++c)
+        {
+            activeSuperCellColorOffsets[c] = gridSuperCells.productOfComponents() +
+                ActiveSuperCellColoring::getOffset(c, gridSuperCells);
+            activeSuperCellSizes[1 + c] = ActiveSuperCellColoring::getSize(c, gridSuperCells);
+        }
     }
 
     /* Shift all particle in a AREA
+     *
+     * Particles are moved to the outbox of their supercell first and pulled
+     * by the destination supercells afterwards. No kernel changes the frame
+     * list of a neighbor supercell, therefore each phase is one launch over
+     * the whole area.
+     *
      * @tparam AREA area which is used (CORE,BORDER,GUARD or a combination)
+     * @param fragmentationThreshold supercells are only compacted if the
+     *                               fraction of gaps in their used frame
+     *                               slots exceeds this value (0 = always)
      */
     template<uint32_t AREA>
-    void shiftParticles()
+    void shiftParticles(float fragmentationThreshold = 0.f)
     {
-        StrideMapping<AREA, 3, MappingDesc> mapper(this->cellDescription);
+        AreaMapping<AREA, MappingDesc> mapper(this->cellDescription);
+        /* destinations can be located one supercell outside of AREA */
+        AreaMapping<CORE + BORDER + GUARD, MappingDesc> destMapper(this->cellDescription);
         ParticlesBoxType pBox = particlesBuffer->getDeviceParticleBox();
         DataSpace<Dim> blockSize(DataSpace<Dim>::create(1));
         blockSize.x() = static_cast<AlpakaIdxSize>(TileSize);
 
         __startTransaction(__getTransactionEvent());
-        do
-        {
-            KernelShiftParticles kernelShiftParticles;
-            __cudaKernel(kernelShiftParticles,
-                         alpaka::dim::DimInt<Dim>,
-                         mapper.getGridDim(),
-                         blockSize)
-                (pBox, mapper);
-
-            KernelFillGaps kernelFillGaps;
-            __cudaKernel(kernelFillGaps,
-                         alpaka::dim::DimInt<Dim>,
-                         mapper.getGridDim(),
-                         blockSize)
-                (pBox, mapper);
-
-            KernelFillGapsLastFrame kernelFillGapsLastFrame;
-            __cudaKernel(kernelFillGapsLastFrame,
-                         alpaka::dim::DimInt<Dim>,
-                         mapper.getGridDim(),
-                         blockSize)
-                (pBox, mapper);
-        }
-        while (mapper.next());
+
+        KernelShiftParticlesToOutbox kernelShiftParticlesToOutbox;
+        __cudaKernel(kernelShiftParticlesToOutbox,
+                     alpaka::dim::DimInt<Dim>,
+                     mapper.getGridDim(),
+                     blockSize)
+            (pBox, mapper);
+
+        KernelShiftParticlesFromOutbox kernelShiftParticlesFromOutbox;
+        __cudaKernel(kernelShiftParticlesFromOutbox,
+                     alpaka::dim::DimInt<Dim>,
+                     destMapper.getGridDim(),
+                     blockSize)
+            (pBox, destMapper);
+
+        KernelRemoveOutbox kernelRemoveOutbox;
+        __cudaKernel(kernelRemoveOutbox,
+                     alpaka::dim::DimInt<Dim>,
+                     mapper.getGridDim(),
+                     blockSize)
+            (pBox, mapper);
+
+        fillGaps<AREA>(fragmentationThreshold);
+
+        __setTransactionEvent(__endTransaction());
+
+    }
+
+    /* First phase of a shift of CORE+BORDER which overlaps the particle
+     * exchange with the CORE
+     *
+     * Moves the particles which leave BORDER into their outboxes and pulls
+     * the GUARD, afterwards the GUARD can be sent. Particles which stay in
+     * CORE+BORDER remain in the outboxes until shiftCoreParticles(), CORE is
+     * not touched.
+     */
+    void shiftBorderParticles()
+    {
+        AreaMapping<BORDER, MappingDesc> mapper(this->cellDescription);
+        AreaMapping<GUARD, MappingDesc> destMapper(this->cellDescription);
+        ParticlesBoxType pBox = particlesBuffer->getDeviceParticleBox();
+        DataSpace<Dim> blockSize(DataSpace<Dim>::create(1));
+        blockSize.x() = static_cast<AlpakaIdxSize>(TileSize);
+
+        __startTransaction(__getTransactionEvent());
+
+        KernelShiftParticlesToOutbox kernelShiftParticlesToOutbox;
+        __cudaKernel(kernelShiftParticlesToOutbox,
+                     alpaka::dim::DimInt<Dim>,
+                     mapper.getGridDim(),
+                     blockSize)
+            (pBox, mapper);
+
+        KernelShiftParticlesFromOutbox kernelShiftParticlesFromOutbox;
+        __cudaKernel(kernelShiftParticlesFromOutbox,
+                     alpaka::dim::DimInt<Dim>,
+                     destMapper.getGridDim(),
+                     blockSize)
+            (pBox, destMapper);
 
         __setTransactionEvent(__endTransaction());
+    }
+
+    /* Second phase of a shift of CORE+BORDER, \see shiftBorderParticles()
+     *
+     * Moves the particles which leave CORE into their outboxes and pulls
+     * CORE+BORDER from the outboxes of both phases. Particles received by the
+     * exchange are not allowed to be inserted before this phase is finished.
+     *
+     * @param fragmentationThreshold \see shiftParticles()
+     */
+    void shiftCoreParticles(float fragmentationThreshold = 0.f)
+    {
+        AreaMapping<CORE, MappingDesc> mapper(this->cellDescription);
+        AreaMapping<CORE + BORDER, MappingDesc> destMapper(this->cellDescription);
+        ParticlesBoxType pBox = particlesBuffer->getDeviceParticleBox();
+        DataSpace<Dim> blockSize(DataSpace<Dim>::create(1));
+        blockSize.x() = static_cast<AlpakaIdxSize>(TileSize);
+
+        __startTransaction(__getTransactionEvent());
+
+        KernelShiftParticlesToOutbox kernelShiftParticlesToOutbox;
+        __cudaKernel(kernelShiftParticlesToOutbox,
+                     alpaka::dim::DimInt<Dim>,
+                     mapper.getGridDim(),
+                     blockSize)
+            (pBox, mapper);
+
+        KernelShiftParticlesFromOutbox kernelShiftParticlesFromOutbox;
+        __cudaKernel(kernelShiftParticlesFromOutbox,
+                     alpaka::dim::DimInt<Dim>,
+                     destMapper.getGridDim(),
+                     blockSize)
+            (pBox, destMapper);
+
+        KernelRemoveOutbox kernelRemoveOutbox;
+        __cudaKernel(kernelRemoveOutbox,
+                     alpaka::dim::DimInt<Dim>,
+                     destMapper.getGridDim(),
+                     blockSize)
+            (pBox, destMapper);
+
+        fillGaps<CORE + BORDER>(fragmentationThreshold);
 
+        __setTransactionEvent(__endTransaction());
     }
 
     /* fill gaps in a AREA
+     *
+     * If AREA contains CORE+BORDER the active supercell list is rebuilt by
+     * the same kernel, an AREA with only a part of CORE invalidates it.
+     *
      * @tparam AREA area which is used (CORE,BORDER,GUARD or a combination)
+     * @param fragmentationThreshold compact only supercells with a larger
+     *                               fraction of gaps (0 = compact all)
      */
     template<uint32_t AREA>
-    void fillGaps()
+    void fillGaps(float fragmentationThreshold = 0.f)
     {
         AreaMapping<AREA, MappingDesc> mapper(this->cellDescription);
 
@@ -125,14 +238,35 @@ protected:
                      alpaka::dim::DimInt<Dim>,
                      mapper.getGridDim(),
                      blockSize)
-            (particlesBuffer->getDeviceParticleBox(), mapper);
+            (particlesBuffer->getDeviceParticleBox(), mapper, fragmentationThreshold);
 
-        KernelFillGapsLastFrame kernelFillGapsLastFrame;
+        /* BORDER is always part of the list, the list is only changed by CORE */
+        const bool updateList = (AREA & (CORE + BORDER)) == (CORE + BORDER);
+        GridBuffer<uint32_t, DIM1>& counters = particlesBuffer->getActiveSuperCellCounters();
+        if (updateList)
+            counters.getDeviceBuffer().setValue(0);
+
+        KernelFillGapsLastFrame<ActiveSuperCellColoring> kernelFillGapsLastFrame;
         __cudaKernel(kernelFillGapsLastFrame,
                      alpaka::dim::DimInt<Dim>,
                      mapper.getGridDim(),
                      blockSize)
-            (particlesBuffer->getDeviceParticleBox(), mapper);
+            (particlesBuffer->getDeviceParticleBox(), mapper, fragmentationThreshold,
+             updateList ? particlesBuffer->getActiveSuperCells().getDeviceBuffer().getPointer() : NULL,
+             updateList ? counters.getDeviceBuffer().getPointer() : NULL);
+
+        if (updateList)
+        {
+#ifndef PMACC_ACC_CPU
+            /* the sizes are used as soon as the copy is finished */
+            counters.deviceToHost();
+#endif
+            activeSuperCellsEvent = __getTransactionEvent();
+            isActiveSuperCellListValid = true;
+            isActiveSuperCellSizeExact = false;
+        }
+        else if ((AREA & CORE) == CORE)
+            isActiveSuperCellListValid = false;
     }
 
 
@@ -169,6 +303,12 @@ public:
      */
     void insertParticles(uint32_t exchangeType);
 
+    /* Resize the adaptive particle exchanges to the traffic since the last call.
+     * All neighbors must call it in the same step, waits for the particle
+     * communication of this species.
+     */
+    void adaptExchangeBuffers();
+
     ParticlesBoxType getDeviceParticlesBox()
     {
         return particlesBuffer->getDeviceParticleBox();
@@ -193,9 +333,62 @@ public:
      */
     EventTask asyncCommunication(EventTask event);
 
+    /* Send the particles in the GUARD to the neighbor devices.
+     * First half of asyncCommunication(), GUARD particles are deleted.
+     */
+    EventTask asyncSendParticles(EventTask event);
+
+    /* Receive particles from the neighbor devices and insert them into BORDER.
+     * Second half of asyncCommunication().
+     */
+    EventTask asyncReceiveParticles(EventTask event);
+
     /* set all internal objects to initial state*/
     virtual void reset(uint32_t currentStep);
 
+    /* Get a mapping over all active supercells (instead of
+     * AreaMapping<CORE+BORDER>).
+     *
+     * The list contains all BORDER supercells (the particle exchange can
+     * insert particles at any time) and the CORE supercells which contain
+     * particles. It is maintained by fillGaps() over CORE+BORDER, which is
+     * part of each shift and of fillAllGaps(), call fillAllGaps() after
+     * particles are created in other ways.
+     * The grid is the last list size known on the host, kernels walk over
+     * the list size on the device with forEachMappedSuperCell().
+     */
+    ActiveSuperCellMapping getActiveSuperCellMapping();
+
+    /* Get a mapping over all active supercells split into colors with
+     * stride Dim (instead of StrideMapping<CORE+BORDER, Dim>), use next()
+     * to walk over the colors, \see getActiveSuperCellMapping()
+     */
+    ActiveSuperCellMapping getActiveSuperCellStrideMapping();
+
+    /* Get a mapping over the active supercells of BORDER (all BORDER
+     * supercells) or CORE only, \see getActiveSuperCellMapping()
+     */
+    ActiveSuperCellMapping getActiveBorderSuperCellMapping();
+    ActiveSuperCellMapping getActiveCoreSuperCellMapping();
+
+private:
+
+    /* rebuild the active supercell list if needed and update the sizes */
+    void prepareActiveSuperCellMapping();
+
+    /* all particle communication started since the last adaptExchangeBuffers() */
+    EventTask communicationEvent;
+    /* last update of the active supercell list and its counters */
+    EventTask activeSuperCellsEvent;
+    bool isActiveSuperCellListValid;
+    /* false if activeSuperCellSizes is from an older list */
+    bool isActiveSuperCellSizeExact;
+    uint32_t numBorderSuperCells;
+    /* number of active CORE supercells followed by the number per color */
+    uint32_t activeSuperCellSizes[1 + ActiveSuperCellColoring::numColors];
+    /* offset of each color in the active supercell list */
+    uint32_t activeSuperCellColorOffsets[ActiveSuperCellColoring::numColors];
+
 };
 
 } //namespace PMacc
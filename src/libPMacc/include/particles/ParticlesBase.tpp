@@ -75,6 +75,85 @@ namespace PMacc
     {
         deleteParticlesInArea<CORE+BORDER+GUARD>();
         particlesBuffer->reset( );
+        isActiveSuperCellListValid = false;
+    }
+
+    template<typename T_ParticleDescription, class MappingDesc>
+    void ParticlesBase<T_ParticleDescription, MappingDesc>::prepareActiveSuperCellMapping()
+    {
+        if (!isActiveSuperCellListValid)
+            fillGaps<CORE + BORDER>();
+
+        if (isActiveSuperCellSizeExact)
+            return;
+
+        GridBuffer<uint32_t, DIM1>& counters = particlesBuffer->getActiveSuperCellCounters();
+        const uint32_t* sizes = NULL;
+#ifdef PMACC_ACC_CPU
+        /* host and accelerator share the memory, read the counters in place */
+        activeSuperCellsEvent.waitForFinished();
+        sizes = counters.getDeviceBuffer().getPointer();
+#else
+        /* do not wait for the device, an older size is used as grid size */
+        if (activeSuperCellsEvent.isFinished())
+            sizes = counters.getHostBuffer().getPointer();
+#endif
+        if (sizes != NULL)
+        {
+            for (uint32_t i = 0; i < 1 + ActiveSuperCellColoring::numColors; ++i)
+                activeSuperCellSizes[i] = sizes[i];
+            isActiveSuperCellSizeExact = true;
+        }
+    }
+
+    template<typename T_ParticleDescription, class MappingDesc>
+    typename ParticlesBase<T_ParticleDescription, MappingDesc>::ActiveSuperCellMapping
+    ParticlesBase<T_ParticleDescription, MappingDesc>::getActiveSuperCellMapping()
+    {
+        prepareActiveSuperCellMapping();
+        return ActiveSuperCellMapping(
+            this->cellDescription,
+            particlesBuffer->getActiveSuperCells().getDeviceBuffer().getPointer(),
+            numBorderSuperCells + activeSuperCellSizes[0],
+            particlesBuffer->getActiveSuperCellCounters().getDeviceBuffer().getPointer(),
+            static_cast<int32_t>(numBorderSuperCells));
+    }
+
+    template<typename T_ParticleDescription, class MappingDesc>
+    typename ParticlesBase<T_ParticleDescription, MappingDesc>::ActiveSuperCellMapping
+    ParticlesBase<T_ParticleDescription, MappingDesc>::getActiveSuperCellStrideMapping()
+    {
+        prepareActiveSuperCellMapping();
+        return ActiveSuperCellMapping(
+            this->cellDescription,
+            particlesBuffer->getActiveSuperCells().getDeviceBuffer().getPointer(),
+            activeSuperCellColorOffsets,
+            activeSuperCellSizes + 1,
+            particlesBuffer->getActiveSuperCellCounters().getDeviceBuffer().getPointer() + 1,
+            ActiveSuperCellColoring::numColors);
+    }
+
+    template<typename T_ParticleDescription, class MappingDesc>
+    typename ParticlesBase<T_ParticleDescription, MappingDesc>::ActiveSuperCellMapping
+    ParticlesBase<T_ParticleDescription, MappingDesc>::getActiveBorderSuperCellMapping()
+    {
+        prepareActiveSuperCellMapping();
+        return ActiveSuperCellMapping(
+            this->cellDescription,
+            particlesBuffer->getActiveSuperCells().getDeviceBuffer().getPointer(),
+            numBorderSuperCells);
+    }
+
+    template<typename T_ParticleDescription, class MappingDesc>
+    typename ParticlesBase<T_ParticleDescription, MappingDesc>::ActiveSuperCellMapping
+    ParticlesBase<T_ParticleDescription, MappingDesc>::getActiveCoreSuperCellMapping()
+    {
+        prepareActiveSuperCellMapping();
+        return ActiveSuperCellMapping(
+            this->cellDescription,
+            particlesBuffer->getActiveSuperCells().getDeviceBuffer().getPointer() + numBorderSuperCells,
+            activeSuperCellSizes[0],
+            particlesBuffer->getActiveSuperCellCounters().getDeviceBuffer().getPointer());
     }
 
     template<typename T_ParticleDescription, class MappingDesc>
@@ -125,17 +204,40 @@ namespace PMacc
         }
     }
 
+    template<typename T_ParticleDescription, class MappingDesc>
+    void ParticlesBase<T_ParticleDescription, MappingDesc>::adaptExchangeBuffers()
+    {
+        /* exchange buffers are reallocated, no communication of this species
+         * is allowed to be in flight (other tasks can continue) */
+        communicationEvent.waitForFinished();
+        particlesBuffer->adaptExchangeBuffers();
+    }
+
     template<typename T_ParticleDescription, class MappingDesc>
     EventTask ParticlesBase<T_ParticleDescription, MappingDesc>::asyncCommunication(EventTask event)
     {
-        EventTask ret;
-        __startTransaction(event);
-        Environment<>::get().ParticleFactory().createTaskParticlesReceive(*this);
-        ret = __endTransaction();
+        EventTask ret = asyncReceiveParticles(event);
+        ret += asyncSendParticles(event);
+        return ret;
+    }
 
+    template<typename T_ParticleDescription, class MappingDesc>
+    EventTask ParticlesBase<T_ParticleDescription, MappingDesc>::asyncSendParticles(EventTask event)
+    {
         __startTransaction(event);
         Environment<>::get().ParticleFactory().createTaskParticlesSend(*this);
-        ret += __endTransaction();
+        EventTask ret = __endTransaction();
+        communicationEvent += ret;
+        return ret;
+    }
+
+    template<typename T_ParticleDescription, class MappingDesc>
+    EventTask ParticlesBase<T_ParticleDescription, MappingDesc>::asyncReceiveParticles(EventTask event)
+    {
+        __startTransaction(event);
+        Environment<>::get().ParticleFactory().createTaskParticlesReceive(*this);
+        EventTask ret = __endTransaction();
+        communicationEvent += ret;
         return ret;
     }
 
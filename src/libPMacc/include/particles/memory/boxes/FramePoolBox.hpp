@@ -0,0 +1,293 @@
+/**
+ * Copyright 2026 agent
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "types.h"
+#include "particles/memory/dataTypes/Pointer.hpp"
+
+#include <mallocMC/mallocMC.hpp>
+
+#if (PMACC_FRAME_POOL == 1) && !defined(PMACC_ACC_CPU)
+#   error "PMACC_FRAME_POOL is only supported for CPU accelerators"
+#endif
+
+namespace PMacc
+{
+
+/** state of a frame pool shared by all threads of a device
+ *
+ * All members are only changed with alpaka atomics or by the owner of the
+ * corresponding list lock.
+ *
+ * @tparam T_numLists number of independent free lists
+ */
+template<uint32_t T_numLists>
+struct FramePoolData
+{
+    /* first frame of each free list, frames are linked via `nextFrame` */
+    unsigned long long int listHead[T_numLists];
+    /* 0 = list is free for popping, 1 = list is owned by a thread */
+    int listLock[T_numLists];
+    /* number of frames taken from a list, only changed by the lock owner */
+    unsigned long long int numTaken[T_numLists];
+    /* number of frames given back to a list */
+    unsigned long long int numReturned[T_numLists];
+    /* first slab, slabs are linked via their header */
+    unsigned long long int firstSlab;
+    unsigned long long int numSlabs;
+    unsigned long long int numFailedSlabs;
+
+    HDINLINE FramePoolData() :
+    firstSlab(0), numSlabs(0), numFailedSlabs(0)
+    {
+        for (uint32_t i = 0; i < T_numLists; ++i)
+        {
+            listHead[i] = 0;
+            listLock[i] = 0;
+            numTaken[i] = 0;
+            numReturned[i] = 0;
+        }
+    }
+};
+
+/** device handle of a frame pool
+ *
+ * Frames are cut from slabs of T_framesPerSlab frames allocated with mallocMC
+ * and recycled via T_numLists free lists (lock-free stacks).
+ * Pushing a frame is lock-free, popping is done only by the thread which owns
+ * the list lock (try-lock, never blocking) so that a popped frame can not be
+ * reused by another thread while the list head is swapped (no ABA problem).
+ * Each thread prefers the list selected by its global thread index and falls
+ * back to the other lists if its list is empty or owned by another thread.
+ *
+ * @tparam T_Frame type of the frames
+ * @tparam T_numLists number of independent free lists
+ * @tparam T_framesPerSlab number of frames allocated with one mallocMC call
+ */
+template<class T_Frame, uint32_t T_numLists = 64u, uint32_t T_framesPerSlab = 16u>
+class FramePoolBox
+{
+public:
+
+    typedef T_Frame FrameType;
+    typedef Pointer<FrameType> FramePtr;
+    typedef FramePoolData<T_numLists> DataType;
+
+    enum
+    {
+        numLists = T_numLists,
+        framesPerSlab = T_framesPerSlab,
+        /* the slab header holds the pointer to the next slab and keeps the
+         * alignment of the frames */
+        slabHeaderBytes = ((sizeof (unsigned long long int) + __alignof__(FrameType) - 1) /
+            __alignof__(FrameType)) * __alignof__(FrameType),
+        slabBytes = slabHeaderBytes + T_framesPerSlab * sizeof (FrameType)
+    };
+
+    HDINLINE FramePoolBox() : data(NULL)
+    {
+    }
+
+    HDINLINE FramePoolBox(DataType* data) : data(data)
+    {
+    }
+
+    /** get a frame from the pool
+     *
+     * The lists are walked until a frame is found. NULL is only returned
+     * after a slab allocation failed and all lists were seen unlocked and
+     * empty within one pass (lists owned by other threads are retried).
+     *
+     * @return pointer to an unused frame, NULL if the pool is exhausted and
+     *         no new slab can be allocated
+     */
+    template<typename T_Acc>
+    DINLINE FrameType* getFrame(T_Acc const & acc) const
+    {
+        const uint32_t firstList = getListHint(acc);
+        bool canAllocateSlab = true;
+        bool isExhausted = false;
+        while (!isExhausted)
+        {
+            /* stays true if no list was locked or had frames in this pass */
+            isExhausted = !canAllocateSlab;
+            for (uint32_t i = 0; i < T_numLists; ++i)
+            {
+                const uint32_t listId = (firstList + i) % T_numLists;
+                if (!tryLock(acc, listId))
+                {
+                    isExhausted = false;
+                    continue;
+                }
+
+                FrameType* frame = pop(acc, listId);
+                if (frame == NULL && canAllocateSlab)
+                {
+                    frame = allocateSlab(acc, listId);
+                    canAllocateSlab = frame != NULL;
+                }
+                if (frame != NULL)
+                    ++(data->numTaken[listId]);
+                unlock(acc, listId);
+
+                if (frame != NULL)
+                {
+                    frame->nextFrame = FramePtr();
+                    frame->previousFrame = FramePtr();
+                    return frame;
+                }
+            }
+        }
+        return NULL;
+    }
+
+    /** give a frame back to the pool
+     *
+     * The frame memory is not released to mallocMC and is reused by the next
+     * getFrame() call of this pool, slabs with only free frames are released
+     * by FramePool::trim().
+     */
+    template<typename T_Acc>
+    DINLINE void returnFrame(T_Acc const & acc, FrameType* frame) const
+    {
+        const uint32_t listId = getListHint(acc);
+        push(acc, listId, frame, frame);
+        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(
+            acc,
+            &(data->numReturned[listId]),
+            1ull);
+    }
+
+private:
+
+    template<typename T_Acc>
+    DINLINE uint32_t getListHint(T_Acc const & acc) const
+    {
+        const auto globalThreadIdx(alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>(acc));
+        uint32_t hint = 0;
+        for (uint32_t d = 0; d < alpaka::dim::Dim<T_Acc>::value; ++d)
+            hint = hint * 31u + static_cast<uint32_t>(globalThreadIdx[d]);
+        return hint % T_numLists;
+    }
+
+    template<typename T_Acc>
+    DINLINE bool tryLock(T_Acc const & acc, uint32_t listId) const
+    {
+        return alpaka::atomic::atomicOp<alpaka::atomic::op::Cas>(
+            acc,
+            &(data->listLock[listId]),
+            0,
+            1) == 0;
+    }
+
+    template<typename T_Acc>
+    DINLINE void unlock(T_Acc const & acc, uint32_t listId) const
+    {
+        alpaka::atomic::atomicOp<alpaka::atomic::op::Exch>(
+            acc,
+            &(data->listLock[listId]),
+            0);
+    }
+
+    /** push the chain `first` ... `last` (linked via nextFrame) to a list */
+    template<typename T_Acc>
+    DINLINE void push(T_Acc const & acc, uint32_t listId, FrameType* first, FrameType* last) const
+    {
+        volatile unsigned long long int* head = &(data->listHead[listId]);
+        unsigned long long int oldHead;
+        do
+        {
+            oldHead = *head;
+            last->nextFrame = FramePtr((FrameType*) oldHead);
+        }
+        while (alpaka::atomic::atomicOp<alpaka::atomic::op::Cas>(
+                   acc,
+                   &(data->listHead[listId]),
+                   oldHead,
+                   (unsigned long long int) first) != oldHead);
+    }
+
+    /** pop one frame, the caller must own the list lock */
+    template<typename T_Acc>
+    DINLINE FrameType* pop(T_Acc const & acc, uint32_t listId) const
+    {
+        volatile unsigned long long int* head = &(data->listHead[listId]);
+        while (true)
+        {
+            const unsigned long long int oldHead = *head;
+            if (oldHead == 0)
+                return NULL;
+            /* only the lock owner removes frames, therefore `oldHead` can not
+             * be taken by an other thread and its next pointer is stable */
+            const unsigned long long int next = (unsigned long long int) ((FrameType*) oldHead)->nextFrame.ptr;
+            if (alpaka::atomic::atomicOp<alpaka::atomic::op::Cas>(
+                    acc,
+                    &(data->listHead[listId]),
+                    oldHead,
+                    next) == oldHead)
+                return (FrameType*) oldHead;
+        }
+    }
+
+    /** allocate a new slab, return the first frame and put all other frames
+     *  to the list `listId`
+     */
+    template<typename T_Acc>
+    DINLINE FrameType* allocateSlab(T_Acc const & acc, uint32_t listId) const
+    {
+        char* slab = (char*) ::mallocMC::malloc(slabBytes);
+        if (slab == NULL)
+        {
+            alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(data->numFailedSlabs), 1ull);
+            return NULL;
+        }
+        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(data->numSlabs), 1ull);
+
+        /* register slab to release it if the pool is destroyed */
+        volatile unsigned long long int* firstSlab = &(data->firstSlab);
+        unsigned long long int oldSlab;
+        do
+        {
+            oldSlab = *firstSlab;
+            *((unsigned long long int*) slab) = oldSlab;
+        }
+        while (alpaka::atomic::atomicOp<alpaka::atomic::op::Cas>(
+                   acc,
+                   &(data->firstSlab),
+                   oldSlab,
+                   (unsigned long long int) slab) != oldSlab);
+
+        FrameType* frames = (FrameType*) (slab + slabHeaderBytes);
+        if (T_framesPerSlab > 1)
+        {
+            for (uint32_t i = 1; i < T_framesPerSlab - 1; ++i)
+                frames[i].nextFrame = FramePtr(frames + i + 1);
+            push(acc, listId, frames + 1, frames + T_framesPerSlab - 1);
+        }
+        return frames;
+    }
+
+    PMACC_ALIGN(data, DataType*);
+};
+
+} //namespace PMacc
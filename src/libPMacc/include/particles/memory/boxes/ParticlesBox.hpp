@@ -28,6 +28,7 @@
 #include "particles/memory/dataTypes/SuperCell.hpp"
 #include "memory/boxes/PitchedBox.hpp"
 #include "particles/memory/dataTypes/Pointer.hpp"
+#include "particles/memory/boxes/FramePoolBox.hpp"
 #include <cstdio>
 
 namespace PMacc
@@ -42,14 +43,20 @@ namespace PMacc
 template<class FRAME, unsigned DIM>
 class ParticlesBox : protected DataBox<PitchedBox<SuperCell<FRAME>, DIM> >
 {
-private:
-    PMACC_ALIGN(hostMemoryOffset,int64_t);
 public:
 
     typedef FRAME FrameType;
     typedef Pointer<FrameType> FramePtr;
     typedef SuperCell<FrameType> SuperCellType;
     typedef DataBox<PitchedBox<SuperCell<FRAME>, DIM> > BaseType;
+    typedef FramePoolBox<FrameType> FramePoolBoxType;
+
+private:
+    PMACC_ALIGN(hostMemoryOffset,int64_t);
+#if (PMACC_FRAME_POOL == 1)
+    PMACC_ALIGN(framePool, FramePoolBoxType);
+#endif
+public:
 
     static const uint32_t Dim = DIM;
 
@@ -75,20 +82,38 @@ public:
 
     }
 
+#if (PMACC_FRAME_POOL == 1)
+    /** box for device frame data which allocates frames from a frame pool
+     *
+     * @param pool handle to the frame pool of the species
+     */
+    HDINLINE ParticlesBox(const DataBox<PitchedBox<SuperCellType, DIM> > &superCells, const FramePoolBoxType &pool) :
+    BaseType(superCells), hostMemoryOffset(0), framePool(pool)
+    {
+
+    }
+#endif
+
     /**
      * Returns an empty frame from data heap.
      *
      * @return an empty frame
      */
     PMACC_NO_NVCC_HDWARNING
-    DINLINE FRAME &getEmptyFrame() const
+    template<
+        typename T_Acc>
+    DINLINE FRAME &getEmptyFrame(T_Acc const & acc) const
     {
 
         FrameType* tmp = NULL;
         const int maxTries = 13; //magic number is not performance critical
         for (int numTries = 0; numTries < maxTries; ++numTries)
         {
+#if (PMACC_FRAME_POOL == 1)
+            tmp = framePool.getFrame(acc);
+#else
             tmp = (FrameType*) ::mallocMC::malloc(sizeof (FrameType));
+#endif
             if (tmp != NULL)
             {
                 /* disable all particles since we can not assume that newly allocated memory contains zeros */
@@ -98,12 +123,12 @@ public:
                 /* takes care that changed values are visible to all threads inside this block*/
                 __threadfence_block();
 #endif
-               // break;
+                break;
             }
             else
             {
                 printf("%s: mallocMC out of memory (try %i of %i)\n",
-                       (numTries+1)==maxTries?"WARNING":"ERROR",
+                       (numTries+1)==maxTries?"ERROR":"WARNING",
                        numTries+1,
                        maxTries);
 
@@ -118,15 +143,21 @@ public:
      *
      * @param frame FRAME to remove
      */
-    DINLINE void removeFrame(FRAME &frame) const
+    template<
+        typename T_Acc>
+    DINLINE void removeFrame(T_Acc const & acc, FRAME &frame) const
     {
+#if (PMACC_FRAME_POOL == 1)
+        framePool.returnFrame(acc, &frame);
+#else
         ::mallocMC::free((void*) &frame);
+#endif
     }
 
     HDINLINE
     FrameType* mapPtr(FrameType* devPtr) const
     {
-#ifndef __CUDA_ARCH__
+#if !defined(__CUDA_ARCH__) && !defined(PMACC_ACC_CPU)
         int64_t useOffset=hostMemoryOffset*static_cast<int64_t>(devPtr!=0);
         return (FrameType*)(((char*)devPtr) - useOffset);
 #else
@@ -274,7 +305,9 @@ public:
      * @param idx position of supercell
      * @return true if more frames in list, else false
      */
-    DINLINE bool removeLastFrame(const DataSpace<DIM> &idx) const
+    template<
+        typename T_Acc>
+    DINLINE bool removeLastFrame(T_Acc const & acc, const DataSpace<DIM> &idx) const
     {
         //!\todo this is not thread save
         FrameType** lastFrameNativPtr = &(getSuperCell(idx).lastFramePtr);
@@ -288,18 +321,71 @@ public:
             {
                 prev->nextFrame = FramePtr(); //set to invalid frame
                 *lastFrameNativPtr = prev.ptr; //set new last frame
-                removeFrame(*last);
+                removeFrame(acc, *last);
                 return true;
             }
             //remove last frame of supercell
             getSuperCell(idx).firstFramePtr = NULL;
             getSuperCell(idx).lastFramePtr = NULL;
 
-            removeFrame(*last);
+            removeFrame(acc, *last);
         }
         return false;
     }
 
+    /**
+     * Returns the first frame of the outbox of a supercell.
+     *
+     * The outbox holds particles which leave the supercell during a shift,
+     * the frames are linked with nextFrame only.
+     *
+     * @param idx position of supercell
+     * @return the first FRAME of the outbox list from supercell
+     */
+    HDINLINE FRAME& getOutboxFrame(const DataSpace<DIM> &idx, bool &isValid) const
+    {
+        FramePtr tmp = FramePtr(mapPtr(getSuperCell(idx).outboxFramePtr));
+        isValid = tmp.isValid();
+        return *tmp;
+    }
+
+    /**
+     * Adds a frame to the outbox of a supercell.
+     * This call is not threadsave, only one thread from a supercell may call this function.
+     *
+     * @param frame frame to add
+     * @param idx position of supercell
+     */
+    HDINLINE void addOutboxFrame(FRAME &frameIn, const DataSpace<DIM> &idx) const
+    {
+        FramePtr frame(&frameIn);
+        FrameType** outboxNativPtr = &(getSuperCell(idx).outboxFramePtr);
+
+        frame->previousFrame = FramePtr();
+        frame->nextFrame = FramePtr(*outboxNativPtr);
+        *outboxNativPtr = frame.ptr;
+    }
+
+    /**
+     * Removes all frames of the outbox of a supercell.
+     * This call is not threadsave, only one thread from a supercell may call this function.
+     *
+     * @param idx position of supercell
+     */
+    template<
+        typename T_Acc>
+    DINLINE void removeOutbox(T_Acc const & acc, const DataSpace<DIM> &idx) const
+    {
+        FramePtr frame(getSuperCell(idx).outboxFramePtr);
+        while (frame.isValid())
+        {
+            FramePtr next(frame->nextFrame);
+            removeFrame(acc, *frame);
+            frame = next;
+        }
+        getSuperCell(idx).outboxFramePtr = NULL;
+    }
+
     HDINLINE SuperCellType& getSuperCell(DataSpace<DIM> idx) const
     {
         return BaseType::operator()(idx);
@@ -0,0 +1,221 @@
+/**
+ * Copyright 2026 agent
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "types.h"
+#include "memory/buffers/GridBuffer.hpp"
+#include "particles/memory/boxes/FramePoolBox.hpp"
+#include "debug/VerboseLog.hpp"
+#include "eventSystem/EventSystem.hpp"
+
+#include <mallocMC/mallocMC.hpp>
+
+#include <map>
+
+namespace PMacc
+{
+
+/** allocation statistics of a frame pool */
+struct FramePoolStatistics
+{
+    /* number of slabs allocated with mallocMC */
+    uint64_t numSlabs;
+    /* number of frames reserved from mallocMC */
+    uint64_t numFramesReserved;
+    /* number of frames handed out since the creation of the pool */
+    uint64_t numFramesTaken;
+    /* number of frames given back since the creation of the pool */
+    uint64_t numFramesReturned;
+    /* number of slab allocations failed because mallocMC was exhausted */
+    uint64_t numFailedSlabs;
+
+    /** number of frames currently in use */
+    uint64_t getNumFramesUsed() const
+    {
+        return numFramesTaken - numFramesReturned;
+    }
+};
+
+/** pool of particle frames of one species
+ *
+ * Owns the device state of a FramePoolBox. Memory of the frames is allocated
+ * from the mallocMC heap in slabs. Frames given back stay in the pool, a slab
+ * is only released to mallocMC by trim() (if all of its frames are free) or
+ * if the pool is destroyed. Therefore the heap must hold the largest number
+ * of frames a species uses at any time, \see memory.param.
+ *
+ * @tparam T_Frame type of the frames
+ * @tparam T_numLists number of independent free lists, should be at least the
+ *                    number of concurrently running threads
+ * @tparam T_framesPerSlab number of frames allocated with one mallocMC call
+ */
+template<class T_Frame, uint32_t T_numLists = 64u, uint32_t T_framesPerSlab = 16u>
+class FramePool
+{
+public:
+
+    typedef FramePoolBox<T_Frame, T_numLists, T_framesPerSlab> FramePoolBoxType;
+    typedef typename FramePoolBoxType::DataType DataType;
+
+    FramePool()
+    {
+        poolData = new GridBuffer<DataType, DIM1 > (DataSpace<DIM1 > (1));
+        poolData->getDeviceBuffer().setValue(DataType());
+    }
+
+    /** release all slabs to mallocMC
+     *
+     * The pool is only used for CPU accelerators, therefore the slab headers
+     * can be read directly from the host.
+     */
+    virtual ~FramePool()
+    {
+        const FramePoolStatistics stats = getStatistics();
+        log<ggLog::MEMORY>("Frame pool: %1% slabs, %2% frames reserved, %3% frames in use, %4% failed slab allocations") %
+            stats.numSlabs % stats.numFramesReserved % stats.getNumFramesUsed() % stats.numFailedSlabs;
+
+        unsigned long long int slab = poolData->getHostBuffer().getDataBox()[0].firstSlab;
+        while (slab != 0)
+        {
+            const unsigned long long int nextSlab = *((unsigned long long int*) slab);
+            ::mallocMC::free((void*) slab);
+            slab = nextSlab;
+        }
+        __delete(poolData);
+    }
+
+    /** release all slabs without a used frame to mallocMC
+     *
+     * Waits for all tasks, no kernel is allowed to use the pool during the
+     * call. The pool is only used for CPU accelerators, therefore the free
+     * lists are walked directly from the host.
+     *
+     * @return number of released slabs
+     */
+    uint64_t trim()
+    {
+        typedef typename FramePoolBoxType::FrameType FrameType;
+        typedef typename FramePoolBoxType::FramePtr FramePtr;
+
+        __getTransactionEvent().waitForFinished();
+        DataType& data = *(poolData->getDeviceBuffer().getBasePointer());
+
+        /* number of free frames of each slab (key: slab address) */
+        std::map<unsigned long long int, uint32_t> freeFrames;
+        for (unsigned long long int slab = data.firstSlab; slab != 0; slab = *((unsigned long long int*) slab))
+            freeFrames[slab] = 0;
+        if (freeFrames.empty())
+            return 0;
+
+        for (uint32_t i = 0; i < T_numLists; ++i)
+        {
+            for (FrameType* frame = (FrameType*) data.listHead[i]; frame != NULL; frame = frame->nextFrame.ptr)
+                ++(getSlab(freeFrames, frame)->second);
+        }
+
+        /* remove the frames of free slabs from the lists */
+        for (uint32_t i = 0; i < T_numLists; ++i)
+        {
+            FrameType* last = NULL;
+            FrameType* frame = (FrameType*) data.listHead[i];
+            data.listHead[i] = 0;
+            while (frame != NULL)
+            {
+                FrameType* next = frame->nextFrame.ptr;
+                if (getSlab(freeFrames, frame)->second != T_framesPerSlab)
+                {
+                    frame->nextFrame = FramePtr();
+                    if (last == NULL)
+                        data.listHead[i] = (unsigned long long int) frame;
+                    else
+                        last->nextFrame = FramePtr(frame);
+                    last = frame;
+                }
+                frame = next;
+            }
+        }
+
+        /* unlink and release the free slabs */
+        uint64_t numReleased = 0;
+        unsigned long long int* link = &(data.firstSlab);
+        while (*link != 0)
+        {
+            const unsigned long long int slab = *link;
+            if (freeFrames[slab] == T_framesPerSlab)
+            {
+                *link = *((unsigned long long int*) slab);
+                ::mallocMC::free((void*) slab);
+                ++numReleased;
+            }
+            else
+                link = (unsigned long long int*) slab;
+        }
+        data.numSlabs -= numReleased;
+        if (numReleased != 0)
+            log<ggLog::MEMORY>("Frame pool: released %1% free slabs") % numReleased;
+        return numReleased;
+    }
+
+    FramePoolBoxType getDeviceFramePoolBox()
+    {
+        return FramePoolBoxType(poolData->getDeviceBuffer().getBasePointer());
+    }
+
+    /** copy the pool state to the host and summarize it
+     *
+     * This call is blocking.
+     */
+    FramePoolStatistics getStatistics()
+    {
+        poolData->deviceToHost();
+        const DataType& data = poolData->getHostBuffer().getDataBox()[0];
+
+        FramePoolStatistics stats;
+        stats.numSlabs = data.numSlabs;
+        stats.numFramesReserved = data.numSlabs * T_framesPerSlab;
+        stats.numFramesTaken = 0;
+        stats.numFramesReturned = 0;
+        stats.numFailedSlabs = data.numFailedSlabs;
+        for (uint32_t i = 0; i < T_numLists; ++i)
+        {
+            stats.numFramesTaken += data.numTaken[i];
+            stats.numFramesReturned += data.numReturned[i];
+        }
+        return stats;
+    }
+
+private:
+
+    /** slab containing a frame */
+    template<typename T_SlabMap, typename T_FrameType>
+    static typename T_SlabMap::iterator getSlab(T_SlabMap& slabs, T_FrameType* frame)
+    {
+        /* last slab which starts before the frame */
+        typename T_SlabMap::iterator it = slabs.upper_bound((unsigned long long int) frame);
+        return --it;
+    }
+
+    GridBuffer<DataType, DIM1>* poolData;
+};
+
+} //namespace PMacc
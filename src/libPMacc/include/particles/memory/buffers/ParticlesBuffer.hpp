@@ -25,8 +25,10 @@
 #include "particles/frame_types.hpp"
 #include "memory/buffers/GridBuffer.hpp"
 #include "particles/memory/boxes/ParticlesBox.hpp"
+#include "particles/memory/buffers/FramePool.hpp"
 #include "dimensions/GridLayout.hpp"
 #include "memory/dataTypes/Mask.hpp"
+#include "mappings/kernel/ListMapping.hpp"
 #include "particles/memory/buffers/StackExchangeBuffer.hpp"
 #include "eventSystem/EventSystem.hpp"
 #include "particles/memory/dataTypes/SuperCell.hpp"
@@ -48,6 +50,12 @@
 #include <boost/mpl/pair.hpp>
 #include "particles/ParticleDescription.hpp"
 #include "particles/memory/dataTypes/ListPointer.hpp"
+#include "communication/manager_common.h"
+#include "Environment.hpp"
+
+#include <mpi.h>
+#include <algorithm>
+#include <vector>
 
 
 namespace PMacc
@@ -126,6 +134,10 @@ public:
     typedef ParticleType FrameType;
     typedef SuperCell<FrameType> SuperCellType;
 
+    /** colors of the active supercell list for kernels which need a
+     *  StrideMapping, the stride is DIM (like the current deposition) */
+    typedef StrideColoring<DIM, DIM> ActiveSuperCellColoring;
+
 private:
 
     /*this is only for internel calculations*/
@@ -134,6 +146,10 @@ private:
         SizeOfOneBorderElement = (sizeof (ParticleTypeBorder) + sizeof (PopPushType))
     };
 
+    /* the exchangeMemoryIndexer uses the communicationTag of the frames with
+     * this bit set (bit 20 of the unique tag, \see GridBuffer::addExchange) */
+    static const uint32_t IndexerCommunicationTagBit = 1u << (20 - 5);
+
 public:
 
     /**
@@ -155,6 +171,24 @@ public:
 
         superCells = new GridBuffer<SuperCellType, DIM > (superCellsCount);
 
+        /* first half: all BORDER and the active CORE supercells, second half: active supercells sorted by color */
+        activeSuperCells = new GridBuffer<DataSpace<DIM>, DIM1 > (DataSpace<DIM1 > (2 * superCellsCount.productOfComponents()));
+        /* active CORE supercells, active supercells per color, BORDER supercells */
+        activeSuperCellCounters = new GridBuffer<uint32_t, DIM1 > (DataSpace<DIM1 > (2 + ActiveSuperCellColoring::numColors));
+
+#if (PMACC_FRAME_POOL == 1)
+        framePool = new FramePool<ParticleType > ();
+#endif
+
+        for (uint32_t ex = 0; ex < numExchanges; ++ex)
+        {
+            exchangeCapacity[ex] = 0;
+            exchangeMinCapacity[ex] = 0;
+            exchangeMaxCapacity[ex] = 0;
+            exchangeHighWaterMark[ex] = 0;
+            exchangeReceiveCapacity[ex] = 0;
+        }
+        exchangeGrowthBudget = 0;
     }
 
     void createParticleBuffer()
@@ -168,8 +202,13 @@ public:
     virtual ~ParticlesBuffer()
     {
         __delete(superCells);
+        __delete(activeSuperCells);
+        __delete(activeSuperCellCounters);
         __delete(framesExchanges);
         __delete(exchangeMemoryIndexer);
+#if (PMACC_FRAME_POOL == 1)
+        __delete(framePool);
+#endif
     }
 
     /**
@@ -180,22 +219,215 @@ public:
 
         superCells->getDeviceBuffer().setValue(SuperCellType ());
         superCells->getHostBuffer().setValue(SuperCellType ());
+#if (PMACC_FRAME_POOL == 1)
+        /* frames deleted before the reset are back in the pool */
+        framePool->trim();
+#endif
     }
 
     /**
      * Adds an exchange buffer to frames.
      *
+     * If minMemory is not zero and less than usedMemory the exchange is
+     * adaptive: it starts with minMemory and is resized between minMemory
+     * and usedMemory by adaptExchangeBuffers().
+     *
      * @param receive Mask describing receive directions
-     * @param usedMemory memory to be used for this exchange
+     * @param usedMemory memory to be used for this exchange (maximum for adaptive exchanges)
+     * @param communicationTag tag of the exchange
+     * @param minMemory initial and minimal memory of an adaptive exchange (0 = fixed size)
      */
-    void addExchange(Mask receive, size_t usedMemory, uint32_t communicationTag)
+    void addExchange(Mask receive, size_t usedMemory, uint32_t communicationTag, size_t minMemory = 0)
     {
-
-        size_t numBorderFrames = usedMemory / SizeOfOneBorderElement;
+        const size_t maxBorderFrames = usedMemory / SizeOfOneBorderElement;
+        size_t numBorderFrames = maxBorderFrames;
+        if (minMemory != 0)
+            numBorderFrames = std::min(numBorderFrames, minMemory / SizeOfOneBorderElement);
 
         framesExchanges->addExchangeBuffer(receive, DataSpace<DIM1 > (numBorderFrames), communicationTag, true);
 
-        exchangeMemoryIndexer->addExchangeBuffer(receive, DataSpace<DIM1 > (numBorderFrames), communicationTag | (1u << (20 - 5)), true);
+        exchangeMemoryIndexer->addExchangeBuffer(receive, DataSpace<DIM1 > (numBorderFrames), communicationTag | IndexerCommunicationTagBit, true);
+
+        /* a full exchange is followed by a further bash round, the frames decide for the indexer */
+        ICommunicator &communicator = Environment<DIM>::get().EnvironmentController().getCommunicator();
+        communicator.setMultiRoundExchange(communicationTag, communicationTag);
+        communicator.setMultiRoundExchange(communicationTag | IndexerCommunicationTagBit, communicationTag);
+
+        if (numBorderFrames != 0 && numBorderFrames < maxBorderFrames)
+        {
+            const Mask send = receive.getMirroredMask();
+            for (uint32_t ex = 1; ex < numExchanges; ++ex)
+            {
+                if (send.isSet(ex))
+                {
+                    exchangeCapacity[ex] = numBorderFrames;
+                    exchangeMinCapacity[ex] = numBorderFrames;
+                    exchangeMaxCapacity[ex] = maxBorderFrames;
+                }
+                if (receive.isSet(ex))
+                    exchangeReceiveCapacity[ex] = numBorderFrames;
+            }
+        }
+    }
+
+    /**
+     * Set the device memory which adaptive exchanges may use to grow.
+     *
+     * The budget must be held back from the mallocMC heap (it is not
+     * allocated here), shrinking exchanges return memory to the budget.
+     *
+     * @param bytes budget in byte
+     */
+    void setExchangeGrowthBudget(size_t bytes)
+    {
+        exchangeGrowthBudget = bytes / SizeOfOneBorderElement;
+    }
+
+    /**
+     * Track the number of particles sent in ex direction.
+     *
+     * @param ex send direction
+     * @param numParticles particles sent in one exchange (sum over all rounds)
+     */
+    void updateExchangeHighWaterMark(uint32_t ex, size_t numParticles)
+    {
+        exchangeHighWaterMark[ex] = std::max(exchangeHighWaterMark[ex], static_cast<uint64_t>(numParticles));
+    }
+
+    /**
+     * Resize all adaptive exchanges to the measured traffic.
+     *
+     * The size of a link (send exchange of this rank and receive exchange of
+     * the neighbor) is negotiated by its two ranks only:
+     *   - the sender proposes a size from its high water mark: grow (to
+     *     twice the high water mark) if the exchange was filled to more than
+     *     3/4 or needed more than one round, shrink (to twice the high water
+     *     mark, at most by half) if it was filled to less than 1/4
+     *   - the receiver grants at most the proposal
+     * Growth is taken from the budget of both ranks
+     * (\see setExchangeGrowthBudget), with an exhausted budget the particles
+     * are sent in further rounds instead.
+     *
+     * The messages use the tags of the particle exchanges, thus this call
+     * must be made in the same step by all neighbors and no particle
+     * communication of this buffer is allowed to be in flight.
+     */
+    void adaptExchangeBuffers()
+    {
+        CommunicatorMPI<DIM>& communicator = Environment<DIM>::get().GridController().getCommunicator();
+        const MPI_Comm comm = communicator.getMPIComm();
+
+        uint64_t proposal[numExchanges];
+        uint64_t neighborProposal[numExchanges];
+        uint64_t grant[numExchanges];
+        uint64_t neighborGrant[numExchanges];
+        std::vector<MPI_Request> requests;
+
+        /* propose a new size for each send exchange, the growth is reserved */
+        for (uint32_t ex = 1; ex < numExchanges; ++ex)
+        {
+            if (exchangeCapacity[ex] == 0 || !framesExchanges->hasSendExchange(ex))
+                continue;
+
+            const size_t capacity = exchangeCapacity[ex];
+            const size_t highWaterMark = static_cast<size_t>(exchangeHighWaterMark[ex]);
+            size_t newCapacity = capacity;
+
+            if (highWaterMark * 4 > capacity * 3)
+                newCapacity = std::min(exchangeMaxCapacity[ex], std::max(highWaterMark * 2, capacity * 2));
+            else if (highWaterMark * 4 < capacity)
+                newCapacity = std::max(exchangeMinCapacity[ex], std::max(highWaterMark * 2, capacity / 2));
+
+            if (newCapacity > capacity)
+            {
+                newCapacity = std::min(newCapacity, capacity + exchangeGrowthBudget);
+                exchangeGrowthBudget -= newCapacity - capacity;
+            }
+            proposal[ex] = newCapacity;
+
+            requests.push_back(MPI_Request());
+            MPI_CHECK(MPI_Isend(&(proposal[ex]), 1, MPI_UINT64_T,
+                                communicator.ExchangeTypeToRank(ex),
+                                gridExchangeTag + framesExchanges->getSendExchange(ex).getCommunicationTag(),
+                                comm, &(requests.back())));
+        }
+        for (uint32_t ex = 1; ex < numExchanges; ++ex)
+        {
+            exchangeHighWaterMark[ex] = 0;
+            if (exchangeReceiveCapacity[ex] == 0 || !framesExchanges->hasReceiveExchange(ex))
+                continue;
+
+            requests.push_back(MPI_Request());
+            MPI_CHECK(MPI_Irecv(&(neighborProposal[ex]), 1, MPI_UINT64_T,
+                                communicator.ExchangeTypeToRank(ex),
+                                gridExchangeTag + framesExchanges->getReceiveExchange(ex).getCommunicationTag(),
+                                comm, &(requests.back())));
+        }
+        if (!requests.empty())
+            MPI_CHECK(MPI_Waitall(static_cast<int>(requests.size()), &(requests[0]), MPI_STATUSES_IGNORE));
+        requests.clear();
+
+        /* grant the proposals of the neighbors and resize the receive exchanges */
+        for (uint32_t ex = 1; ex < numExchanges; ++ex)
+        {
+            if (exchangeReceiveCapacity[ex] == 0 || !framesExchanges->hasReceiveExchange(ex))
+                continue;
+
+            const size_t capacity = exchangeReceiveCapacity[ex];
+            size_t newCapacity = static_cast<size_t>(neighborProposal[ex]);
+            if (newCapacity > capacity)
+            {
+                newCapacity = std::min(newCapacity, capacity + exchangeGrowthBudget);
+                exchangeGrowthBudget -= newCapacity - capacity;
+            }
+            else
+                exchangeGrowthBudget += capacity - newCapacity;
+            grant[ex] = newCapacity;
+
+            requests.push_back(MPI_Request());
+            MPI_CHECK(MPI_Isend(&(grant[ex]), 1, MPI_UINT64_T,
+                                communicator.ExchangeTypeToRank(ex),
+                                gridExchangeTag + exchangeMemoryIndexer->getReceiveExchange(ex).getCommunicationTag(),
+                                comm, &(requests.back())));
+
+            if (newCapacity != capacity)
+            {
+                framesExchanges->resizeReceiveExchangeBuffer(ex, DataSpace<DIM1 > (newCapacity), true);
+                exchangeMemoryIndexer->resizeReceiveExchangeBuffer(ex, DataSpace<DIM1 > (newCapacity), true);
+                exchangeReceiveCapacity[ex] = newCapacity;
+            }
+        }
+        for (uint32_t ex = 1; ex < numExchanges; ++ex)
+        {
+            if (exchangeCapacity[ex] == 0 || !framesExchanges->hasSendExchange(ex))
+                continue;
+
+            requests.push_back(MPI_Request());
+            MPI_CHECK(MPI_Irecv(&(neighborGrant[ex]), 1, MPI_UINT64_T,
+                                communicator.ExchangeTypeToRank(ex),
+                                gridExchangeTag + exchangeMemoryIndexer->getSendExchange(ex).getCommunicationTag(),
+                                comm, &(requests.back())));
+        }
+        if (!requests.empty())
+            MPI_CHECK(MPI_Waitall(static_cast<int>(requests.size()), &(requests[0]), MPI_STATUSES_IGNORE));
+
+        /* resize the send exchanges to the granted size, return the unused reservation */
+        for (uint32_t ex = 1; ex < numExchanges; ++ex)
+        {
+            if (exchangeCapacity[ex] == 0 || !framesExchanges->hasSendExchange(ex))
+                continue;
+
+            const size_t capacity = exchangeCapacity[ex];
+            const size_t newCapacity = static_cast<size_t>(neighborGrant[ex]);
+            exchangeGrowthBudget += std::max(capacity, static_cast<size_t>(proposal[ex])) - newCapacity;
+
+            if (newCapacity != capacity)
+            {
+                framesExchanges->resizeSendExchangeBuffer(ex, DataSpace<DIM1 > (newCapacity), true);
+                exchangeMemoryIndexer->resizeSendExchangeBuffer(ex, DataSpace<DIM1 > (newCapacity), true);
+                exchangeCapacity[ex] = newCapacity;
+            }
+        }
     }
 
     /**
@@ -206,10 +438,28 @@ public:
     ParticlesBox<ParticleType, DIM> getDeviceParticleBox()
     {
 
+#if (PMACC_FRAME_POOL == 1)
+        return ParticlesBox<ParticleType, DIM > (
+                                                 superCells->getDeviceBuffer().getDataBox(),
+                                                 framePool->getDeviceFramePoolBox());
+#else
         return ParticlesBox<ParticleType, DIM > (
                                                  superCells->getDeviceBuffer().getDataBox());
+#endif
     }
 
+#if (PMACC_FRAME_POOL == 1)
+    /**
+     * Returns allocation statistics of the frame pool.
+     *
+     * This call is blocking.
+     */
+    FramePoolStatistics getFramePoolStatistics()
+    {
+        return framePool->getStatistics();
+    }
+#endif
+
     /**
      * Returns a ParticlesBox for host frame data.
      *
@@ -217,11 +467,43 @@ public:
      */
     ParticlesBox<ParticleType, DIM> getHostParticleBox(int64_t memoryOffset)
     {
-
+#ifdef PMACC_ACC_CPU
+        /* host and accelerator share the address space, use the device data in place */
+        return ParticlesBox<ParticleType, DIM > (
+                                                 superCells->getDeviceBuffer().getDataBox(),
+                                                 memoryOffset
+                                                );
+#else
         return ParticlesBox<ParticleType, DIM > (
                                                  superCells->getHostBuffer().getDataBox(),
                                                  memoryOffset
                                                 );
+#endif
+    }
+
+    /**
+     * Returns the list of supercells which contain particles.
+     *
+     * The list is filled while the gaps of CORE+BORDER are filled,
+     * \see ParticlesBase::fillGaps().
+     *
+     * @return buffer with all BORDER supercells and the active CORE supercells
+     *         followed by the active supercells sorted by color
+     */
+    GridBuffer<DataSpace<DIM>, DIM1>& getActiveSuperCells()
+    {
+        return *activeSuperCells;
+    }
+
+    /**
+     * Returns the counters of the active supercell list.
+     *
+     * @return buffer with the number of active CORE supercells, the number
+     *         per color and the number of BORDER supercells added so far
+     */
+    GridBuffer<uint32_t, DIM1>& getActiveSuperCellCounters()
+    {
+        return *activeSuperCellCounters;
     }
 
     /**
@@ -330,7 +612,15 @@ public:
 
     void deviceToHost()
     {
+#ifdef PMACC_ACC_CPU
+        /* zero-copy: getHostParticleBox() uses the device data, only wait
+         * until all kernels which could change the supercells are finished */
+        __startOperation(ITask::TASK_CUDA);
+        __startOperation(ITask::TASK_HOST);
+        Environment<>::get().StreamController().waitForAll();
+#else
         superCells->deviceToHost();
+#endif
     }
 
 
@@ -338,11 +628,33 @@ private:
     GridBuffer<PopPushType, DIM1> *exchangeMemoryIndexer;
 
     GridBuffer<SuperCellType, DIM> *superCells;
+    GridBuffer<DataSpace<DIM>, DIM1> *activeSuperCells;
+    GridBuffer<uint32_t, DIM1> *activeSuperCellCounters;
     /*gridbuffer for hold borderFrames, we need a own buffer to create first exchanges without core momory*/
     GridBuffer< ParticleType, DIM1, ParticleTypeBorder> *framesExchanges;
 
+#if (PMACC_FRAME_POOL == 1)
+    FramePool<ParticleType> *framePool;
+#endif
+
     DataSpace<DIM> superCellSize;
     DataSpace<DIM> gridSize;
 
+    enum
+    {
+        numExchanges = 27
+    };
+
+    /* capacity of adaptive send exchanges in particles (0 = fixed size) */
+    size_t exchangeCapacity[numExchanges];
+    size_t exchangeMinCapacity[numExchanges];
+    size_t exchangeMaxCapacity[numExchanges];
+    /* maximum of sent particles per exchange since last adaptExchangeBuffers() */
+    uint64_t exchangeHighWaterMark[numExchanges];
+    /* capacity of adaptive receive exchanges in particles, index is the receive direction */
+    size_t exchangeReceiveCapacity[numExchanges];
+    /* particles which adaptive exchanges can still grow by (send and receive) */
+    size_t exchangeGrowthBudget;
+
 };
 }
@@ -37,8 +37,11 @@ public:
     HDINLINE SuperCell() :
     firstFramePtr(NULL),
     lastFramePtr(NULL),
+    outboxFramePtr(NULL),
     mustShiftVal(false),
-    sizeLastFrame(0)
+    sizeLastFrame(0),
+    numParticles(0),
+    numGaps(0)
     {
     }
 
@@ -82,13 +85,54 @@ public:
         sizeLastFrame = size;
     }
 
+    /** number of particles in the supercell
+     *
+     * only updated by the particle shift, therefore it is an estimate
+     */
+    HDINLINE uint32_t getNumParticles()
+    {
+        return numParticles;
+    }
+
+    HDINLINE void setNumParticles(uint32_t value)
+    {
+        numParticles = value;
+    }
+
+    /** number of empty slots (without the free slots of the last frame) */
+    HDINLINE uint32_t getNumGaps()
+    {
+        return numGaps;
+    }
+
+    HDINLINE void setNumGaps(uint32_t value)
+    {
+        numGaps = value;
+    }
+
+    /** check if the frames must be compacted
+     *
+     * @param threshold maximal fraction of gaps in the used slots,
+     *                  0 compacts always
+     */
+    HDINLINE bool mustCompact(float threshold)
+    {
+        return threshold <= 0.f ||
+            static_cast<float>(numGaps) > threshold * static_cast<float>(numParticles + numGaps);
+    }
+
 
 private:
     PMACC_ALIGN(mustShiftVal, bool);
     PMACC_ALIGN(sizeLastFrame, lcellId_t);
+    PMACC_ALIGN(numParticles, uint32_t);
+    PMACC_ALIGN(numGaps, uint32_t);
 public:
     PMACC_ALIGN(firstFramePtr, TYPE*);
     PMACC_ALIGN(lastFramePtr, TYPE*);
+    /* singly linked list of frames with particles leaving this supercell
+     * (only valid while particles are shifted) */
+    PMACC_ALIGN(outboxFramePtr, TYPE*);
 };
 
 } //end namespace
@@ -25,9 +25,11 @@
 #include "types.h"
 #include "memory/buffers/GridBuffer.hpp"
 #include "mappings/kernel/AreaMapping.hpp"
+#include "mappings/kernel/ListMapping.hpp"
 
 #include "particles/particleFilter/FilterFactory.hpp"
 #include "particles/particleFilter/PositionFilter.hpp"
+#include "particles/Identifier.hpp"
 
 namespace PMacc
 {
@@ -66,39 +68,42 @@ ALPAKA_FN_ACC void operator()(
     typedef typename Mapping::SuperCellSize SuperCellSize;
 
     const int linearThreadIdx = DataSpaceOperations<Dim>::template map<SuperCellSize > (threadIndex);
-    const DataSpace<Dim> superCellIdx(mapper.getSuperCellIndex(DataSpace<Dim > (blockIndex)));
 
-    if (linearThreadIdx == 0)
+    forEachMappedSuperCell(acc, mapper, blockIndex, [&](DataSpace<Dim> const & superCellIdx)
     {
-        frame = &(pb.getLastFrame(superCellIdx, isValid));
-        particlesInSuperCell = pb.getSuperCell(superCellIdx).getSizeLastFrame();
-        counter = 0;
-    }
-    alpaka::block::sync::syncBlockThreads(acc);
-    if (!isValid)
-        return; //end kernel if we have no frames
-    filter.setSuperCellPosition((superCellIdx - mapper.getGuardingSuperCells()) * mapper.getSuperCellSize());
-    while (isValid)
-    {
-        if (linearThreadIdx < particlesInSuperCell)
+        if (linearThreadIdx == 0)
         {
-            if (filter(*frame, linearThreadIdx))
-                alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &counter, 1);
+            frame = &(pb.getLastFrame(superCellIdx, isValid));
+            particlesInSuperCell = pb.getSuperCell(superCellIdx).getSizeLastFrame();
+            counter = 0;
         }
         alpaka::block::sync::syncBlockThreads(acc);
-        if (linearThreadIdx == 0)
+        if (!isValid)
+            return; //end supercell if we have no frames
+        filter.setSuperCellPosition((superCellIdx - mapper.getGuardingSuperCells()) * mapper.getSuperCellSize());
+        while (isValid)
         {
-            frame = &(pb.getPreviousFrame(*frame, isValid));
-            particlesInSuperCell = math::CT::volume<SuperCellSize>::type::value;
+            /* frames can contain gaps */
+            if (linearThreadIdx < particlesInSuperCell && (*frame)[linearThreadIdx][multiMask_] == 1)
+            {
+                if (filter(*frame, linearThreadIdx))
+                    alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &counter, 1);
+            }
+            alpaka::block::sync::syncBlockThreads(acc);
+            if (linearThreadIdx == 0)
+            {
+                frame = &(pb.getPreviousFrame(*frame, isValid));
+                particlesInSuperCell = math::CT::volume<SuperCellSize>::type::value;
+            }
+            alpaka::block::sync::syncBlockThreads(acc);
         }
-        alpaka::block::sync::syncBlockThreads(acc);
-    }
 
-    alpaka::block::sync::syncBlockThreads(acc);
-    if (linearThreadIdx == 0)
-    {
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, gCounter, (uint64_cu) counter);
-    }
+        alpaka::block::sync::syncBlockThreads(acc);
+        if (linearThreadIdx == 0)
+        {
+            alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, gCounter, (uint64_cu) counter);
+        }
+    });
 }
 };
 
@@ -117,9 +122,26 @@ struct CountParticles
     template<uint32_t AREA, class PBuffer, class Filter, class CellDesc>
     static uint64_cu countOnDevice(PBuffer& buffer, CellDesc cellDescription, Filter filter)
     {
-        GridBuffer<uint64_cu, DIM1> counter(DataSpace<DIM1>(1));
-
+        if (AREA == CORE + BORDER)
+        {
+            /* only supercells which contain particles */
+            return countWithMapper(buffer, buffer.getActiveSuperCellMapping(), filter);
+        }
         AreaMapping<AREA, CellDesc> mapper(cellDescription);
+        return countWithMapper(buffer, mapper, filter);
+    }
+
+    /** Get particle count in all supercells of a mapper
+     *
+     * @param buffer source particle buffer
+     * @param mapper mapper which selects the supercells
+     * @param filter filter instance which must inherit from PositionFilter
+     * @return number of particles in the supercells of the mapper
+     */
+    template<class PBuffer, class Mapper, class Filter>
+    static uint64_cu countWithMapper(PBuffer& buffer, const Mapper& mapper, Filter filter)
+    {
+        GridBuffer<uint64_cu, DIM1> counter(DataSpace<DIM1>(1));
 
         KernelCountParticles kernelCountParticles;
 
@@ -127,7 +149,7 @@ struct CountParticles
             kernelCountParticles,
             alpaka::dim::DimInt<3u>,
             mapper.getGridDim(),
-            CellDesc::SuperCellSize::toRT())(
+            Mapper::SuperCellSize::toRT())(
                 buffer.getDeviceParticlesBox(),
                 counter.getDeviceBuffer().getBasePointer(),
                 filter,
@@ -44,7 +44,7 @@ namespace PMacc
         state(Constructor),
         maxSize(parBase.getParticlesBuffer().getSendExchangeStack(exchange).getMaxParticlesCount()),
         initDependency(__getTransactionEvent()),
-        lastSize(0),lastSendEvent(EventTask()){ }
+        lastSize(0),sentSize(0),lastSendEvent(EventTask()){ }
 
         virtual void init()
         {
@@ -71,6 +71,7 @@ namespace PMacc
                         //bash is finished
                         __startTransaction();
                         lastSize = parBase.getParticlesBuffer().getSendExchangeStack(exchange).getDeviceParticlesCurrentSize();
+                        sentSize += lastSize;
                        // std::cout<<"bsend = "<<parBase.getParticlesBuffer().getSendExchangeStack(exchange).getDeviceCurrentSize()<<std::endl;
                         lastSendEvent = parBase.getParticlesBuffer().asyncSendParticles(EventTask(), exchange, tmpEvent);
                         __endTransaction();
@@ -92,7 +93,10 @@ namespace PMacc
 
                         }
                         else
+                        {
+                            parBase.getParticlesBuffer().updateExchangeHighWaterMark(exchange, sentSize);
                             state = WaitForSendEnd;
+                        }
                     }
                     break;
                 case WaitForSendEnd:
@@ -146,6 +150,8 @@ namespace PMacc
         uint32_t exchange;
         size_t maxSize;
         size_t lastSize;
+        /* particles sent in all rounds */
+        size_t sentSize;
     };
 
 } //namespace PMacc
@@ -148,6 +148,23 @@ namespace PMacc
             }
         }
 
+        /**
+         * Check if any plugin is notified in a step.
+         *
+         * @param currentStep current simulation iteration step
+         * @return true if notifyPlugins(currentStep) notifies at least one object
+         */
+        bool hasNotifications(uint32_t currentStep) const
+        {
+            for (NotificationList::const_iterator iter = notificationList.begin();
+                    iter != notificationList.end(); ++iter)
+            {
+                if (currentStep % iter->second == 0)
+                    return true;
+            }
+            return false;
+        }
+
         /**
          * Notifies plugins that a restartable checkpoint should be dumped.
          *
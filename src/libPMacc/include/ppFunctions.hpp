@@ -34,6 +34,18 @@
 #define PMACC_MAX_DO(what,x,y) (((x)>(y))?x what:y what)
 #define PMACC_MIN_DO(what,x,y) (((x)<(y))?x what:y what)
 
+/**
+ * Hint the compiler to vectorize the following loop.
+ *
+ * Only used for host code compiled with OpenMP 4.0 or newer, else empty.
+ * The loop must not contain dependencies between iterations.
+ */
+#if !defined(__CUDA_ARCH__) && defined(_OPENMP) && (_OPENMP >= 201307)
+#   define PMACC_PRAGMA_SIMD _Pragma("omp simd")
+#else
+#   define PMACC_PRAGMA_SIMD
+#endif
+
 /**
  * Returns number of args... arguments.
  *
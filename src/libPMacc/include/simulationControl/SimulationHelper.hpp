@@ -109,6 +109,16 @@ public:
      */
     virtual void movingWindowCheck(uint32_t currentStep) = 0;
 
+    /**
+     * Notifies registered plugins, called by dumpOneStep before checkpointing.
+     *
+     *  @param currentStep simulation step
+     */
+    virtual void notifyPlugins(uint32_t currentStep)
+    {
+        Environment<DIM>::get().PluginConnector().notifyPlugins(currentStep);
+    }
+
     /**
      * Notifies registered output classes.
      *
@@ -121,14 +131,14 @@ public:
         Environment<DIM>::get().DataConnector().invalidate();
 
         /* trigger notification */
-        Environment<DIM>::get().PluginConnector().notifyPlugins(currentStep);
+        notifyPlugins(currentStep);
 
         /* trigger checkpoint notification */
         if (checkpointPeriod && (currentStep % checkpointPeriod == 0))
         {
             /* first synchronize: if something failed, we can spare the time
              * for the checkpoint writing */
-            alpaka::wait::wait(Environment<>::get().DeviceManager().getAccDevice());
+            Environment<>::get().StreamController().waitForAll();
 
             GridController<DIM> &gc = Environment<DIM>::get().GridController();
             /* can be spared for better scalings, but allows to spare the
@@ -146,7 +156,7 @@ public:
 
             /* important synchronize: only if no errors occured until this
              * point guarantees that a checkpoint is usable */
-            alpaka::wait::wait(Environment<>::get().DeviceManager().getAccDevice());
+            Environment<>::get().StreamController().waitForAll();
 
             /* \todo in an ideal world with MPI-3, this would be an
              * MPI_Ibarrier call and this function would return a MPI_Request
@@ -48,17 +48,61 @@ namespace PMacc
     #define PMACC_ACC_CPU
 #endif
 
+/** CPU only: use blocking streams
+ *
+ * By default each stream of the StreamController owns a worker thread and
+ * kernels and copies are executed asynchronously to the host thread which
+ * drives the event system and the MPI communication.
+ */
+#ifndef PMACC_CPU_SYNC_STREAM
+    #define PMACC_CPU_SYNC_STREAM 0
+#endif
+
+/** Launch mode of kernels written for the element layer
+ *
+ * Such kernels iterate over their cells with PMacc::ForEachIdx and are
+ * started with __cudaKernelElements (or __picKernelAreaElements).
+ *
+ * 0: thread layer, one alpaka thread per cell (default, required for CUDA)
+ * 1: element layer, one alpaka thread per block, the cells of a block are
+ *    the elements of this thread. Blocks are distributed over the OpenMP
+ *    threads (AccCpuOmp2Blocks) and block synchronizations are for free.
+ */
+#ifndef PMACC_KERNEL_ELEMENT_LAYER
+    #define PMACC_KERNEL_ELEMENT_LAYER 0
+#endif
+
+/** CPU only: allocate particle frames from a per species frame pool
+ *
+ * Frames are cut from slabs of the mallocMC heap and recycled via lock-free
+ * free lists instead of calling mallocMC for each frame.
+ * @see particles/memory/buffers/FramePool.hpp
+ */
+#ifndef PMACC_FRAME_POOL
+#   ifdef PMACC_ACC_CPU
+#       define PMACC_FRAME_POOL 1
+#   else
+#       define PMACC_FRAME_POOL 0
+#   endif
+#endif
+
     using AlpakaHostDev = alpaka::dev::DevCpu;
 #ifdef PMACC_ACC_CPU
     using AlpakaAccDev = alpaka::dev::DevCpu;
-    //using AlpakaAccStream = alpaka::stream::StreamCpuAsync;
+#if (PMACC_CPU_SYNC_STREAM == 1)
     using AlpakaAccStream = alpaka::stream::StreamCpuSync;
+#else
+    using AlpakaAccStream = alpaka::stream::StreamCpuAsync;
+#endif
+    /* stream for one-shot operations which are waited for immediately */
+    using AlpakaAccStreamSync = alpaka::stream::StreamCpuSync;
     template<
         typename TDim>
     using AlpakaAcc = alpaka::acc::AccCpuOmp2Threads<TDim, AlpakaIdxSize>;
 #else
     using AlpakaAccDev = alpaka::dev::DevCudaRt;
     using AlpakaAccStream = alpaka::stream::StreamCudaRtAsync;
+    using AlpakaAccStreamSync = alpaka::stream::StreamCudaRtSync;
     template<
         typename TDim
     >
@@ -0,0 +1,135 @@
+/**
+ * Copyright 2013-2015 Rene Widera
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "simulation_defines.hpp"
+#include "simulation_types.hpp"
+
+#include "fields/FieldE.hpp"
+#include "fields/FieldB.hpp"
+#include "traits/AggregateFieldHalos.hpp"
+
+#include "eventSystem/EventSystem.hpp"
+#include "dataManagement/ISimulationData.hpp"
+#include "memory/buffers/CommunicationGroup.hpp"
+
+#include <memory>
+#include <string>
+
+namespace picongpu
+{
+using namespace PMacc;
+
+namespace emfCommunication
+{
+
+/** returns the current GridBuffer of a field
+ *
+ * The field is asked for each access because the solver can swap the
+ * front and back buffer (traits::UsesFieldBackBuffer).
+ */
+template<class T_Field>
+struct GetFieldGridBuffer
+{
+    T_Field* field;
+
+    GridBuffer<typename T_Field::ValueType, simDim>& operator()() const
+    {
+        return field->getGridBuffer();
+    }
+};
+
+} //namespace emfCommunication
+
+/** communicate the guards of FieldE and FieldB
+ *
+ * Sends one message per neighbor for both fields if
+ * traits::AggregateFieldHalos is true for the used field solver,
+ * else each field is communicated on its own.
+ *
+ * Owned by the simulation, must be deleted before the fields. The instance
+ * is registered at the DataConnector to be used by the field solvers.
+ */
+class EMFCommunication : public ISimulationData
+{
+public:
+
+    EMFCommunication(FieldE& fieldE, FieldB& fieldB) :
+    fieldE(fieldE),
+    fieldB(fieldB)
+    {
+        if (traits::AggregateFieldHalos<fieldSolver::FieldSolver>::value)
+        {
+            group.reset(new CommunicationGroup<simDim>(FIELD_EB));
+
+            emfCommunication::GetFieldGridBuffer<FieldE> getFieldE;
+            getFieldE.field = &fieldE;
+            group->addMember(getFieldE);
+
+            emfCommunication::GetFieldGridBuffer<FieldB> getFieldB;
+            getFieldB.field = &fieldB;
+            group->addMember(getFieldB);
+        }
+
+        Environment<>::get().DataConnector().registerData(*this);
+    }
+
+    virtual ~EMFCommunication() = default;
+
+    /**
+     * @param serialEvent event to wait for before the communication starts
+     * @return event of the receive of both fields and of the copy of the send data
+     */
+    EventTask asyncCommunication(EventTask serialEvent)
+    {
+        if (!group)
+        {
+            EventTask eRfieldE = fieldE.asyncCommunication(serialEvent);
+            EventTask eRfieldB = fieldB.asyncCommunication(serialEvent);
+            return eRfieldE + eRfieldB;
+        }
+
+        return group->asyncCommunication(serialEvent);
+    }
+
+    static std::string getName()
+    {
+        return std::string("EMFCommunication");
+    }
+
+    SimulationDataId getUniqueId()
+    {
+        return getName();
+    }
+
+    void synchronize()
+    {
+    }
+
+private:
+
+    FieldE& fieldE;
+    FieldB& fieldB;
+    /* only created if the halos of both fields are aggregated */
+    std::unique_ptr<CommunicationGroup<simDim> > group;
+};
+
+} //namespace picongpu
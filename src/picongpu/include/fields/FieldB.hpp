@@ -83,6 +83,20 @@ namespace picongpu
 
         GridBuffer<ValueType, simDim> &getGridBuffer();
 
+        /** device data box of the back buffer
+         *
+         * only valid if the field solver uses a back buffer
+         * (traits::UsesFieldBackBuffer)
+         */
+        DataBoxType getDeviceBackDataBox();
+
+        /** exchange front and back buffer
+         *
+         * The guards of the new front buffer are outdated and must be
+         * communicated before they are read.
+         */
+        void swapBackBuffer();
+
         SimulationDataId getUniqueId();
 
         void synchronize();
@@ -96,6 +110,8 @@ namespace picongpu
         void laserManipulation(uint32_t currentStep);
 
         GridBuffer<ValueType, simDim> *fieldB;
+        /* second buffer for out of place field solvers, else NULL */
+        GridBuffer<ValueType, simDim> *fieldBBack;
 
         FieldE *fieldE;
         LaserPhysics *laser;
@@ -47,10 +47,12 @@
 #include "math/Vector.hpp"
 
 #include <list>
+#include <utility>
 
 #include <boost/mpl/accumulate.hpp>
 #include "particles/traits/GetInterpolation.hpp"
 #include "traits/GetMargin.hpp"
+#include "traits/UsesFieldBackBuffer.hpp"
 
 namespace picongpu
 {
@@ -59,10 +61,13 @@ using namespace PMacc;
 
 FieldB::FieldB( MappingDesc cellDescription ) :
 SimulationFieldHelper<MappingDesc>( cellDescription ),
+fieldBBack( NULL ),
 fieldE( NULL )
 {
     /*#####create FieldB###############*/
     fieldB = new GridBuffer<ValueType, simDim > ( cellDescription.getGridLayout( ) );
+    if ( traits::UsesFieldBackBuffer<fieldSolver::FieldSolver>::value )
+        fieldBBack = new GridBuffer<ValueType, simDim > ( cellDescription.getGridLayout( ) );
 
     typedef bmpl::accumulate<
         VectorAllSpecies,
@@ -101,6 +106,8 @@ fieldE( NULL )
         for ( uint32_t d = 0; d < simDim; ++d )
             guardingCells[d] = ( relativMask[d] == -1 ? originGuard[d] : endGuard[d] );
         fieldB->addExchange( GUARD, i, guardingCells, FIELD_B );
+        if ( fieldBBack != NULL )
+            fieldBBack->addExchange( GUARD, i, guardingCells, FIELD_B_BACK );
     }
 
 }
@@ -108,6 +115,7 @@ fieldE( NULL )
 FieldB::~FieldB( )
 {
     __delete(fieldB);
+    __delete(fieldBBack);
 }
 
 SimulationDataId FieldB::getUniqueId()
@@ -166,10 +174,22 @@ GridBuffer<FieldB::ValueType, simDim> &FieldB::getGridBuffer( )
     return *fieldB;
 }
 
+FieldB::DataBoxType FieldB::getDeviceBackDataBox( )
+{
+    return fieldBBack->getDeviceBuffer( ).getDataBox( );
+}
+
+void FieldB::swapBackBuffer( )
+{
+    std::swap( fieldB, fieldBBack );
+}
+
 void FieldB::reset( uint32_t )
 {
     fieldB->getHostBuffer( ).reset( true );
     fieldB->getDeviceBuffer( ).reset( false );
+    if ( fieldBBack != NULL )
+        fieldBBack->getDeviceBuffer( ).reset( false );
 }
 
 HDINLINE
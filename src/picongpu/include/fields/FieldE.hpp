@@ -81,6 +81,20 @@ namespace picongpu
 
         GridBuffer<ValueType,simDim>& getGridBuffer();
 
+        /** device data box of the back buffer
+         *
+         * only valid if the field solver uses a back buffer
+         * (traits::UsesFieldBackBuffer)
+         */
+        DataBoxType getDeviceBackDataBox();
+
+        /** exchange front and back buffer
+         *
+         * The guards of the new front buffer are outdated and must be
+         * communicated before they are read.
+         */
+        void swapBackBuffer();
+
         GridLayout<simDim> getGridLayout();
 
         SimulationDataId getUniqueId();
@@ -97,6 +111,8 @@ namespace picongpu
 
 
         GridBuffer<ValueType,simDim> *fieldE;
+        /* second buffer for out of place field solvers, else NULL */
+        GridBuffer<ValueType,simDim> *fieldEBack;
 
         FieldB *fieldB;
 
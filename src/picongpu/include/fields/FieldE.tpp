@@ -43,9 +43,11 @@
 #include "math/Vector.hpp"
 
 #include <list>
+#include <utility>
 
 #include "particles/traits/GetInterpolation.hpp"
 #include "traits/GetMargin.hpp"
+#include "traits/UsesFieldBackBuffer.hpp"
 #include <boost/mpl/accumulate.hpp>
 #include "fields/LaserPhysics.hpp"
 
@@ -55,9 +57,12 @@ using namespace PMacc;
 
 FieldE::FieldE( MappingDesc cellDescription ) :
 SimulationFieldHelper<MappingDesc>( cellDescription ),
+fieldEBack( NULL ),
 fieldB( NULL )
 {
     fieldE = new GridBuffer<ValueType, simDim > ( cellDescription.getGridLayout( ) );
+    if ( traits::UsesFieldBackBuffer<fieldSolver::FieldSolver>::value )
+        fieldEBack = new GridBuffer<ValueType, simDim > ( cellDescription.getGridLayout( ) );
 
     typedef bmpl::accumulate<
         VectorAllSpecies,
@@ -96,12 +101,15 @@ fieldB( NULL )
         for ( uint32_t d = 0; d < simDim; ++d )
             guardingCells[d] = ( relativMask[d] == -1 ? originGuard[d] : endGuard[d] );
         fieldE->addExchange( GUARD, i, guardingCells, FIELD_E );
+        if ( fieldEBack != NULL )
+            fieldEBack->addExchange( GUARD, i, guardingCells, FIELD_E_BACK );
     }
 }
 
 FieldE::~FieldE( )
 {
     __delete(fieldE);
+    __delete(fieldEBack);
 }
 
 SimulationDataId FieldE::getUniqueId()
@@ -147,6 +155,16 @@ GridBuffer<FieldE::ValueType, simDim> &FieldE::getGridBuffer( )
     return *fieldE;
 }
 
+FieldE::DataBoxType FieldE::getDeviceBackDataBox( )
+{
+    return fieldEBack->getDeviceBuffer( ).getDataBox( );
+}
+
+void FieldE::swapBackBuffer( )
+{
+    std::swap( fieldE, fieldEBack );
+}
+
 GridLayout< simDim> FieldE::getGridLayout( )
 {
     return cellDescription.getGridLayout( );
@@ -187,6 +205,8 @@ void FieldE::reset( uint32_t )
 {
     fieldE->getHostBuffer( ).reset( true );
     fieldE->getDeviceBuffer( ).reset( false );
+    if ( fieldEBack != NULL )
+        fieldEBack->getDeviceBuffer( ).reset( false );
 }
 
 
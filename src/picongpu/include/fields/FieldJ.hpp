@@ -124,6 +124,11 @@ public:
 
 private:
 
+    /* launch the current deposition for all domains of a stride mapper */
+    template<int T_workerMultiplier, class T_BlockArea, uint32_t AREA, class T_Mapper, class T_ParBox, class T_FrameSolver>
+    void computeCurrentWithMapper(T_Mapper& mapper, const DataSpace<simDim>& blockSize,
+                                  const DataBoxType& jBox, const T_ParBox& pBox, const T_FrameSolver& solver);
+
     GridBuffer<ValueType, simDim> fieldJ;
     GridBuffer<ValueType, simDim>* fieldJrecv;
 
@@ -143,6 +148,13 @@ struct ComputeCurrent
         typedef T_SpeciesName SpeciesName;
         typedef typename SpeciesName::type SpeciesType;
 
+#if (ENABLE_FUSED_CURRENT == 1)
+        /* current of a pushed species is already deposited in Particles::updateBorder() */
+        typedef typename HasFlag<typename SpeciesType::FrameType, particlePusher<> >::type hasPusher;
+        if (hasPusher::value)
+            return;
+#endif
+
         PMACC_AUTO(speciesPtr, tuple[SpeciesName()]);
         fieldJ->computeCurrent<T_Area::value, SpeciesType> (*speciesPtr, currentStep);
     }
@@ -62,13 +62,24 @@ fieldJ( cellDescription.getGridLayout( ) ), fieldJrecv( NULL ), fieldE( NULL ),
         VectorAllSpecies,
         typename PMacc::math::CT::make_Int<simDim, 0>::type,
         PMacc::math::CT::max<bmpl::_1, GetLowerMargin< GetCurrentSolver<bmpl::_2> > >
-        >::type LowerMarginShapes;
+        >::type LowerMarginSolvers;
 
     typedef bmpl::accumulate<
         VectorAllSpecies,
         typename PMacc::math::CT::make_Int<simDim, 0>::type,
         PMacc::math::CT::max<bmpl::_1, GetUpperMargin< GetCurrentSolver<bmpl::_2> > >
-        >::type UpperMarginShapes;
+        >::type UpperMarginSolvers;
+
+#if (ENABLE_CURRENT == 1) && (ENABLE_FUSED_CURRENT == 1)
+    /* the fused push and deposition runs before the particles are shifted,
+     * a particle can be one cell outside of its supercell (e.g. in the GUARD) */
+    typedef typename PMacc::math::CT::make_Int<simDim, 1>::type OneCell;
+    typedef PMacc::math::CT::add<LowerMarginSolvers, OneCell>::type LowerMarginShapes;
+    typedef PMacc::math::CT::add<UpperMarginSolvers, OneCell>::type UpperMarginShapes;
+#else
+    typedef LowerMarginSolvers LowerMarginShapes;
+    typedef UpperMarginSolvers UpperMarginShapes;
+#endif
 
     /* margins are always positive, also for lower margins
      * additional current interpolations and current filters on FieldJ might
@@ -287,19 +298,36 @@ void FieldJ::computeCurrent( ParticlesClass &parClass, uint32_t )
         typename GetMargin<ParticleCurrentSolver>::UpperMargin
         > BlockArea;
 
-    StrideMapping<AREA, simDim, MappingDesc> mapper( cellDescription );
     typename ParticlesClass::ParticlesBoxType pBox = parClass.getDeviceParticlesBox( );
     FieldJ::DataBoxType jBox = this->fieldJ.getDeviceBuffer( ).getDataBox( );
     FrameSolver solver( DELTA_T );
 
-    DataSpace<simDim> blockSize( mapper.getSuperCellSize( ) );
+    DataSpace<simDim> blockSize( MappingDesc::SuperCellSize::toRT( ) );
     blockSize[simDim - 1] *= workerMultiplier;
 
     __startAtomicTransaction( __getTransactionEvent( ) );
+    if( AREA == CORE + BORDER )
+    {
+        /* only supercells with particles, split into the colors of a stride mapping */
+        typename ParticlesClass::ActiveSuperCellMapping mapper( parClass.getActiveSuperCellStrideMapping( ) );
+        computeCurrentWithMapper<workerMultiplier, BlockArea, AREA>( mapper, blockSize, jBox, pBox, solver );
+    }
+    else
+    {
+        StrideMapping<AREA, simDim, MappingDesc> mapper( cellDescription );
+        computeCurrentWithMapper<workerMultiplier, BlockArea, AREA>( mapper, blockSize, jBox, pBox, solver );
+    }
+    __setTransactionEvent( __endTransaction( ) );
+}
+
+template<int T_workerMultiplier, class T_BlockArea, uint32_t AREA, class T_Mapper, class T_ParBox, class T_FrameSolver>
+void FieldJ::computeCurrentWithMapper( T_Mapper& mapper, const DataSpace<simDim>& blockSize,
+                                       const DataBoxType& jBox, const T_ParBox& pBox, const T_FrameSolver& solver )
+{
     do
     {
-        KernelComputeCurrent<workerMultiplier, BlockArea, AREA> kernelComputeCurrent;
-        __cudaKernel(
+        KernelComputeCurrent<T_workerMultiplier, T_BlockArea, AREA> kernelComputeCurrent;
+        __cudaKernelElements(
             kernelComputeCurrent,
             alpaka::dim::DimInt<simDim>,
             mapper.getGridDim( ),
@@ -310,7 +338,6 @@ void FieldJ::computeCurrent( ParticlesClass &parClass, uint32_t )
                 mapper );
     }
     while ( mapper.next( ) );
-    __setTransactionEvent( __endTransaction( ) );
 }
 
 template<uint32_t AREA, class T_CurrentInterpolation>
@@ -29,6 +29,7 @@
 #include <dataManagement/DataConnector.hpp>
 #include <fields/FieldB.hpp>
 #include <fields/FieldE.hpp>
+#include <fields/EMFCommunication.hpp>
 #include "math/Vector.hpp"
 #include <cuSTL/algorithm/kernel/ForeachBlock.hpp>
 #include <lambda/Expression.hpp>
@@ -104,6 +105,7 @@ public:
 
         FieldE& fieldE = dc.getData<FieldE > (FieldE::getName(), true);
         FieldB& fieldB = dc.getData<FieldB > (FieldB::getName(), true);
+        EMFCommunication& emfCommunication = dc.getData<EMFCommunication > (EMFCommunication::getName(), true);
 
         BOOST_AUTO(fieldE_coreBorder,
             fieldE.getGridBuffer().getDeviceBuffer().
@@ -126,8 +128,7 @@ public:
                   fieldB_coreBorder.origin(),
                   gridSize);
 
-        __setTransactionEvent(fieldE.asyncCommunication(__getTransactionEvent()));
-        __setTransactionEvent(fieldB.asyncCommunication(__getTransactionEvent()));
+        __setTransactionEvent(emfCommunication.asyncCommunication(__getTransactionEvent()));
 
         typedef PMacc::math::CT::Int<1,2,0> Orientation_Y;
         propagate<Orientation_Y>(
@@ -135,8 +136,7 @@ public:
                   fieldB_coreBorder.origin(),
                   gridSize);
 
-        __setTransactionEvent(fieldE.asyncCommunication(__getTransactionEvent()));
-        __setTransactionEvent(fieldB.asyncCommunication(__getTransactionEvent()));
+        __setTransactionEvent(emfCommunication.asyncCommunication(__getTransactionEvent()));
 
         typedef PMacc::math::CT::Int<2,0,1> Orientation_Z;
         propagate<Orientation_Z>(
@@ -147,8 +147,7 @@ public:
         if (laserProfile::INIT_TIME > float_X(0.0))
             dc.getData<FieldE > (FieldE::getName(), true).laserManipulation(currentStep);
 
-        __setTransactionEvent(fieldE.asyncCommunication(__getTransactionEvent()));
-        __setTransactionEvent(fieldB.asyncCommunication(__getTransactionEvent()));
+        __setTransactionEvent(emfCommunication.asyncCommunication(__getTransactionEvent()));
     }
 
     void update_afterCurrent(uint32_t) const
@@ -157,14 +156,13 @@ public:
 
         FieldE& fieldE = dc.getData<FieldE > (FieldE::getName(), true);
         FieldB& fieldB = dc.getData<FieldB > (FieldB::getName(), true);
+        EMFCommunication& emfCommunication = dc.getData<EMFCommunication > (EMFCommunication::getName(), true);
 
-        EventTask eRfieldE = fieldE.asyncCommunication(__getTransactionEvent());
-        EventTask eRfieldB = fieldB.asyncCommunication(__getTransactionEvent());
-        __setTransactionEvent(eRfieldE);
-        __setTransactionEvent(eRfieldB);
+        __setTransactionEvent(emfCommunication.asyncCommunication(__getTransactionEvent()));
 
         dc.releaseData(FieldE::getName());
         dc.releaseData(FieldB::getName());
+        dc.releaseData(EMFCommunication::getName());
     }
 };
 
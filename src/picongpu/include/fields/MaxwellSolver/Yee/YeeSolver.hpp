@@ -35,8 +35,12 @@
 #include "memory/boxes/SharedBox.hpp"
 #include "nvidia/functors/Assign.hpp"
 #include "mappings/threads/ThreadCollective.hpp"
+#include "mappings/threads/ForEachIdx.hpp"
 #include "memory/boxes/CachedBox.hpp"
 #include "dimensions/DataSpace.hpp"
+#include "dimensions/GridLayout.hpp"
+#include "memory/dataTypes/Mask.hpp"
+#include "mappings/simulation/GridController.hpp"
 #include <fields/FieldE.hpp>
 #include <fields/FieldB.hpp>
 
@@ -76,7 +80,7 @@ private:
                 > BlockArea;
 
         KernelUpdateE<BlockArea, CurlB> kernelUpdateE;
-        __picKernelArea(
+        __picKernelAreaElements(
             kernelUpdateE,
             alpaka::dim::DimInt<simDim>,
             cellDescription,
@@ -96,7 +100,7 @@ private:
                 > BlockArea;
 
         KernelUpdateBHalf<BlockArea, CurlE> kernelUpdateBHalf;
-        __picKernelArea(
+        __picKernelAreaElements(
             kernelUpdateBHalf,
             alpaka::dim::DimInt<simDim>,
             cellDescription,
@@ -118,9 +122,11 @@ public:
 
     void update_beforeCurrent(uint32_t)
     {
-        updateBHalf < CORE+BORDER >();
+        /* BORDER first, the halo of B is in flight while CORE is computed */
+        updateBHalf < BORDER >();
         EventTask eRfieldB = fieldB->asyncCommunication(__getTransactionEvent());
 
+        updateBHalf < CORE >();
         updateE<CORE>();
         __setTransactionEvent(eRfieldB);
         updateE<BORDER>();
@@ -145,6 +151,103 @@ public:
     }
 };
 
+template<class CurlE, class CurlB>
+class YeeSolverFused
+{
+private:
+    typedef MappingDesc::SuperCellSize SuperCellSize;
+
+
+    FieldE* fieldE;
+    FieldB* fieldB;
+    MappingDesc cellDescription;
+    /* the second half step of B is identical to the unfused solver */
+    YeeSolver<CurlE, CurlB> yeeSolver;
+
+    template<uint32_t AREA>
+    void updateBHalfE()
+    {
+        /* Courant-Friedrichs-Levy-Condition for Yee Field Solver: */
+        static_assert(
+            (SPEED_OF_LIGHT*SPEED_OF_LIGHT*DELTA_T*DELTA_T*INV_CELL2_SUM)<=1.0,
+            "Courant Friedrichs Levy condition failure. Check your gridConfig.param file.");
+
+        typedef SuperCellDescription<
+                SuperCellSize,
+                typename CurlB::LowerMargin,
+                typename CurlB::UpperMargin
+                > BlockAreaB;
+
+        typedef SuperCellDescription<
+                SuperCellSize,
+                typename picongpu::traits::GetMargin<YeeSolverFused, FIELD_E>::LowerMargin,
+                typename picongpu::traits::GetMargin<YeeSolverFused, FIELD_E>::UpperMargin
+                > BlockAreaE;
+
+        /* B is updated in CORE+BORDER and in each GUARD with a neighbor,
+         * this is what the unfused solver gets from the B communication */
+        const GridLayout<simDim> layout(cellDescription.getGridLayout());
+        const Mask commMask(Environment<simDim>::get().GridController().getCommunicationMask());
+        const uint32_t lowerExchange[] = {LEFT, BOTTOM, BACK};
+        const uint32_t upperExchange[] = {RIGHT, TOP, FRONT};
+        DataSpace<simDim> updateBBegin;
+        DataSpace<simDim> updateBEnd;
+        for (uint32_t d = 0; d < simDim; ++d)
+        {
+            updateBBegin[d] = commMask.isSet(lowerExchange[d]) ? 0 : layout.getGuard()[d];
+            updateBEnd[d] = layout.getDataSpace()[d] -
+                (commMask.isSet(upperExchange[d]) ? 0 : layout.getGuard()[d]);
+        }
+
+        KernelUpdateBHalfE<BlockAreaE, BlockAreaB, CurlE, CurlB> kernelUpdateBHalfE;
+        __picKernelAreaElements(
+            kernelUpdateBHalfE,
+            alpaka::dim::DimInt<simDim>,
+            cellDescription,
+            AREA,
+            SuperCellSize::toRT())(
+                this->fieldE->getDeviceBackDataBox(),
+                this->fieldB->getDeviceBackDataBox(),
+                this->fieldE->getDeviceDataBox(),
+                this->fieldB->getDeviceDataBox(),
+                updateBBegin,
+                updateBEnd);
+    }
+
+public:
+
+    YeeSolverFused(MappingDesc cellDescription) :
+    cellDescription(cellDescription),
+    yeeSolver(cellDescription)
+    {
+        DataConnector &dc = Environment<>::get().DataConnector();
+
+        this->fieldE = &dc.getData<FieldE > (FieldE::getName(), true);
+        this->fieldB = &dc.getData<FieldB > (FieldB::getName(), true);
+    }
+
+    /** B half step and E update in one pass
+     *
+     * The guards of E and B are valid from the last update_afterCurrent()
+     * and the widened E margin allows to compute B in the halo of each
+     * supercell, therefore no communication is needed between both updates.
+     * After the swap the guards are outdated, this is fine because E and B
+     * are only read cell local (current interpolation) until
+     * update_afterCurrent() communicates E and B again.
+     */
+    void update_beforeCurrent(uint32_t)
+    {
+        updateBHalfE < CORE + BORDER > ();
+        fieldE->swapBackBuffer();
+        fieldB->swapBackBuffer();
+    }
+
+    void update_afterCurrent(uint32_t currentStep)
+    {
+        yeeSolver.update_afterCurrent(currentStep);
+    }
+};
+
 } // yeeSolver
 
 } // picongpu
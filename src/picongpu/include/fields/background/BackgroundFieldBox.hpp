@@ -0,0 +1,204 @@
+/**
+ * Copyright 2014-2015 Axel Huebl, Benjamin Worpitz
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "types.h"
+#include "simulation_defines.hpp"
+
+#include "dimensions/DataSpace.hpp"
+#include "mappings/simulation/SubGrid.hpp"
+#include "simulationControl/MovingWindow.hpp"
+#include "fields/background/IBackgroundStorage.hpp"
+
+
+namespace picongpu
+{
+namespace cellwiseOperation
+{
+    using namespace PMacc;
+
+    /** read-only data box of a field plus a background field
+     *
+     *  Each access evaluates the background functor at the total cell index,
+     *  the field itself is not modified. Used to fill the field caches of
+     *  kernels instead of adding the background to the whole field.
+     *
+     * \tparam T_FieldBox data box of the field
+     * \tparam T_Background background functor like FieldBackgroundE
+     */
+    template<typename T_FieldBox, typename T_Background>
+    class BackgroundFieldBox
+    {
+    public:
+        typedef typename T_FieldBox::ValueType ValueType;
+
+        /**
+         * \param totalCellOffset total cell index of the origin of fieldBox
+         * \param currentStep the current time step
+         */
+        HDINLINE BackgroundFieldBox( const T_FieldBox& fieldBox,
+                                     const T_Background& background,
+                                     const DataSpace<simDim>& totalCellOffset,
+                                     const uint32_t currentStep ) :
+            fieldBox(fieldBox), background(background),
+            totalCellOffset(totalCellOffset), currentStep(currentStep)
+        {}
+
+        HDINLINE ValueType
+        operator()( const DataSpace<simDim>& idx ) const
+        {
+            return fieldBox( idx ) + background( totalCellOffset + idx, currentStep );
+        }
+
+        HDINLINE BackgroundFieldBox
+        shift( const DataSpace<simDim>& offset ) const
+        {
+            return BackgroundFieldBox( fieldBox.shift( offset ), background,
+                                       totalCellOffset + offset, currentStep );
+        }
+
+    private:
+        PMACC_ALIGN(fieldBox, T_FieldBox);
+        /* no PMACC_ALIGN(...), see TWTS in fieldBackground.param */
+        T_Background background;
+        PMACC_ALIGN(totalCellOffset, DataSpace<simDim>);
+        PMACC_ALIGN(currentStep, uint32_t);
+    };
+
+    /** total cell index of the first cell (including the GUARD) of the local domain
+     *
+     * \param currentStep the current time step, used for the slides of the moving window
+     */
+    HINLINE DataSpace<simDim>
+    getTotalCellOffsetWithGuard( const uint32_t currentStep )
+    {
+        const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
+        DataSpace<simDim> totalCellOffset( subGrid.getLocalDomain().offset );
+        const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter( currentStep );
+
+        /** Assumption: all GPUs have the same number of cells in
+         *              y direction for sliding window */
+        totalCellOffset.y() += numSlides * subGrid.getLocalDomain().size.y();
+        totalCellOffset -= MappingDesc::SuperCellSize::toRT() * int(GUARD_SIZE);
+        return totalCellOffset;
+    }
+
+    namespace detail
+    {
+        /* background functors with a prepare() method (e.g. a tabulated TWTS field) */
+        template<typename T_Background>
+        HINLINE auto
+        prepareBackground( T_Background& background, const uint32_t currentStep, int )
+            -> decltype( background.prepare( currentStep, DataSpace<simDim>() ), void() )
+        {
+            background.prepare( currentStep, getTotalCellOffsetWithGuard( currentStep ) );
+        }
+
+        template<typename T_Background>
+        HINLINE void
+        prepareBackground( T_Background&, const uint32_t, long )
+        {
+        }
+
+        /* background functors with a createStorage() method */
+        template<typename T_Background>
+        HINLINE auto
+        createBackgroundStorage( const T_Background& background, int )
+            -> decltype( background.createStorage() )
+        {
+            return background.createStorage();
+        }
+
+        template<typename T_Background>
+        HINLINE IBackgroundStorage*
+        createBackgroundStorage( const T_Background&, long )
+        {
+            return NULL;
+        }
+    } // namespace detail
+
+    /** call background.prepare(currentStep, totalCellOffsetWithGuard) if it exists
+     *
+     *  Must be called on the host before a background functor is passed to a kernel.
+     */
+    template<typename T_Background>
+    HINLINE void
+    prepareBackground( T_Background& background, const uint32_t currentStep )
+    {
+        detail::prepareBackground( background, currentStep, 0 );
+    }
+
+    /** call background.createStorage() if it exists
+     *
+     *  Must be called before the particle heap is initialized, the caller
+     *  owns the returned storage and deletes it at the end of the simulation.
+     *
+     * \return storage of the background or NULL if it needs none
+     */
+    template<typename T_Background>
+    HINLINE IBackgroundStorage*
+    createBackgroundStorage( const T_Background& background )
+    {
+        return detail::createBackgroundStorage( background, 0 );
+    }
+
+    /** device data box of a field as seen by the particles
+     *
+     *  Adds T_Background on the fly if it influences the particle pusher,
+     *  else it is the plain data box of the field.
+     *
+     * \tparam T_Field field like FieldE
+     * \tparam T_Background background functor like FieldBackgroundE
+     */
+    template<
+        typename T_Field,
+        typename T_Background,
+        bool T_enabled = T_Background::InfluenceParticlePusher>
+    struct GetPusherFieldBox
+    {
+        typedef typename T_Field::DataBoxType type;
+
+        static HINLINE type
+        get( T_Field& field, const uint32_t )
+        {
+            return field.getDeviceDataBox();
+        }
+    };
+
+    template<typename T_Field, typename T_Background>
+    struct GetPusherFieldBox<T_Field, T_Background, true>
+    {
+        typedef BackgroundFieldBox<typename T_Field::DataBoxType, T_Background> type;
+
+        static HINLINE type
+        get( T_Field& field, const uint32_t currentStep )
+        {
+            T_Background background( field.getUnit() );
+            prepareBackground( background, currentStep );
+            return type( field.getDeviceDataBox(),
+                         background,
+                         getTotalCellOffsetWithGuard( currentStep ),
+                         currentStep );
+        }
+    };
+
+} // namespace cellwiseOperation
+} // namespace picongpu
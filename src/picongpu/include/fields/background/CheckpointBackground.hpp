@@ -0,0 +1,87 @@
+/**
+ * Copyright 2014-2015 Axel Huebl, Benjamin Worpitz
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "types.h"
+#include "simulation_defines.hpp"
+
+#include "fields/FieldE.hpp"
+#include "fields/FieldB.hpp"
+#include "fields/background/cellwiseOperation.hpp"
+#include "dataManagement/DataConnector.hpp"
+#include "mappings/kernel/MappingDescription.hpp"
+#include "nvidia/functors/Sub.hpp"
+
+
+namespace picongpu
+{
+namespace fieldBackground
+{
+    using namespace PMacc;
+
+    /** name of the uint32 file attribute which tells if E and B contain the
+     *  background fields of the particle pusher
+     *
+     * Checkpoint format: the pusher background is only added to E and B
+     * while plugins are notified, checkpoints store the fields without it
+     * (value 0), dumps written by plugins contain it (value 1).
+     * Files without this attribute were written by older versions, which
+     * always kept the background in E and B.
+     */
+    static const char* const containedAttributeName = "fieldsContainBackground";
+
+    /** value of containedAttributeName for a file
+     *
+     * @param isCheckpoint true if the file is a checkpoint
+     */
+    inline uint32_t containedInFile(const bool isCheckpoint)
+    {
+        return isCheckpoint ? 0u : 1u;
+    }
+
+    /** remove the pusher background from E and B loaded at a restart
+     *
+     * Must be called after the fields were loaded from a file which contains
+     * the background (attribute is 1 or missing).
+     *
+     * @param cellDescription mapping description of the fields
+     * @param restartStep step of the loaded file
+     */
+    inline void removeAfterRestart(MappingDesc cellDescription, uint32_t restartStep)
+    {
+        namespace nvfct = PMacc::nvidia::functors;
+
+        DataConnector &dc = Environment<>::get().DataConnector();
+        FieldE* fieldE = &(dc.getData<FieldE > (FieldE::getName(), true));
+        FieldB* fieldB = &(dc.getData<FieldB > (FieldB::getName(), true));
+
+        cellwiseOperation::CellwiseOperation < CORE + BORDER + GUARD > pushBGField(cellDescription);
+        pushBGField( fieldE, nvfct::Sub(), FieldBackgroundE(fieldE->getUnit()),
+                     restartStep, FieldBackgroundE::InfluenceParticlePusher );
+        pushBGField( fieldB, nvfct::Sub(), FieldBackgroundB(fieldB->getUnit()),
+                     restartStep, FieldBackgroundB::InfluenceParticlePusher );
+
+        dc.releaseData(FieldE::getName());
+        dc.releaseData(FieldB::getName());
+    }
+
+} // namespace fieldBackground
+} // namespace picongpu
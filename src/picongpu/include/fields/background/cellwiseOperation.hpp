@@ -27,6 +27,7 @@
 #include "mappings/simulation/SubGrid.hpp"
 #include "mappings/kernel/MappingDescription.hpp"
 #include "simulationControl/MovingWindow.hpp"
+#include "fields/background/BackgroundFieldBox.hpp"
 
 
 namespace picongpu
@@ -119,6 +120,8 @@ namespace cellwiseOperation
             else if( T_Area == CORE )
                 totalCellOffset += cellDescription.getSuperCellSize() * cellDescription.getBorderSuperCells();
 
+            prepareBackground( valFunctor, currentStep );
+
             KernelCellwiseOperation kernelCellwiseOperation;
             /* start kernel */
             __picKernelArea(
@@ -30,6 +30,8 @@
 #include "mappings/simulation/SubGrid.hpp"
 #include "math/Complex.hpp"
 
+#include <stdexcept>
+
 #include "fields/background/templates/TWTS/RotateField.tpp"
 #include "fields/background/templates/TWTS/GetInitialTimeDelay_SI.tpp"
 #include "fields/background/templates/TWTS/getFieldPositions_SI.tpp"
@@ -55,12 +57,14 @@ namespace twts
                     const float_X beta_0,
                     const float_64 tdelay_user_SI,
                     const bool auto_tdelay,
-                    const PolarizationType pol ) :
+                    const PolarizationType pol,
+                    const float_X tabulationError ) :
         focus_y_SI(focus_y_SI), wavelength_SI(wavelength_SI),
         pulselength_SI(pulselength_SI), w_x_SI(w_x_SI),
         w_y_SI(w_y_SI), phi(phi), beta_0(beta_0),
         tdelay_user_SI(tdelay_user_SI), dt(SI::DELTA_T_SI),
-        unit_length(UNIT_LENGTH), auto_tdelay(auto_tdelay), pol(pol)
+        unit_length(UNIT_LENGTH), auto_tdelay(auto_tdelay), pol(pol),
+        tabulationError(tabulationError), quadrature(false)
     {
         /* Note: Enviroment-objects cannot be instantiated on CUDA GPU device. Since this is done
          * on host (see fieldBackground.param), this is no problem.
@@ -271,6 +275,9 @@ namespace twts
     BField::operator()( const DataSpace<simDim>& cellIdx,
                             const uint32_t currentStep ) const
     {
+        if( table.covers(cellIdx, currentStep) )
+            return table(cellIdx, currentStep);
+
         const float_64 time_SI = float_64(currentStep) * dt - tdelay;
 
         const PMacc::math::Vector<floatD_64,detail::numComponents> bFieldPositions_SI =
@@ -434,7 +441,7 @@ namespace twts
             )*pmMath::pow(helpVar3,float_T(-1.5))
         ) / (float_T(2.0)*helpVar5*pmMath::sqrt(helpVar6));
 
-        return result.get_real() / UNIT_SPEED;
+        return ( quadrature ? result.get_imag() : result.get_real() ) / UNIT_SPEED;
     }
 
     /** Calculate the Bz(r,t) field
@@ -540,7 +547,7 @@ namespace twts
                                     *pmMath::sqrt( (om0*rho0) / helpVar3 )
                                   ) / pmMath::pow(helpVar7,float_T(1.5));
 
-        return result.get_real() / UNIT_SPEED;
+        return ( quadrature ? result.get_imag() : result.get_real() ) / UNIT_SPEED;
     }
 
     /** Calculate the Bx(r,t) field
@@ -698,7 +705,32 @@ namespace twts
             / pmMath::sqrt(helpVar4)
         );
 
-        return result.get_real() / UNIT_SPEED;
+        return ( quadrature ? result.get_imag() : result.get_real() ) / UNIT_SPEED;
+    }
+
+    HINLINE void
+    BField::prepare( const uint32_t currentStep,
+                     const DataSpace<simDim>& totalCellOffset )
+    {
+        if( tabulationError <= float_X(0.0) )
+            return;
+
+        FieldTable<BField>* fieldTable = FieldTable<BField>::getInstance();
+        if( fieldTable == NULL )
+            throw std::runtime_error( "TWTS: the field table was not created, see createStorage()" );
+
+        const float_64 omega0_SI = float_64(2.0 * PI) * SI::SPEED_OF_LIGHT_SI / wavelength_SI;
+        table = fieldTable->update( *this, currentStep, totalCellOffset,
+                                    tabulationError, omega0_SI );
+    }
+
+    HINLINE cellwiseOperation::IBackgroundStorage*
+    BField::createStorage() const
+    {
+        if( tabulationError <= float_X(0.0) )
+            return NULL;
+
+        return new FieldTable<BField>();
     }
 
 } /* namespace twts */
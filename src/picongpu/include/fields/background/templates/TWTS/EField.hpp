@@ -26,6 +26,7 @@
 #include "math/Vector.hpp"
 #include "dimensions/DataSpace.hpp"
 #include "fields/background/templates/TWTS/numComponents.hpp"
+#include "fields/background/templates/TWTS/FieldTable.hpp"
 
 namespace picongpu
 {
@@ -89,6 +90,14 @@ public:
     PMACC_ALIGN(auto_tdelay, const bool);
     /* Polarization of TWTS laser */
     PMACC_ALIGN(pol, const PolarizationType);
+    /* Maximal absolute error of the tabulated field, normalized to the peak
+     * amplitude. If <= 0.0 the field is always evaluated analytically. */
+    PMACC_ALIGN(tabulationError, const float_X);
+    /* Envelope table of the field, see prepare() */
+    PMACC_ALIGN(table, FieldTableBox);
+    /* Return the imaginary instead of the real part of the complex field,
+     * used to sample the envelope of the field */
+    PMACC_ALIGN(quadrature, bool);
 
     /** Electric field of the TWTS laser
      *
@@ -108,6 +117,9 @@ public:
      *  inside the simulation volume at simulation start timestep = 0 [default = true]
      * \param pol dtermines the TWTS laser polarization, which is either normal or parallel
      *  to the laser pulse front tilt plane [ default= LINEAR_X , LINEAR_YZ ]
+     * \param tabulationError if > 0.0 the field is interpolated in time from an
+     *  envelope table with this maximal absolute error (normalized to the
+     *  peak amplitude), see prepare() [default = 0.0: analytic field]
      */
     HINLINE
     EField( const float_64 focus_y_SI,
@@ -119,7 +131,8 @@ public:
             const float_X beta_0            = 1.0,
             const float_64 tdelay_user_SI   = 0.0,
             const bool auto_tdelay          = true,
-            const PolarizationType pol      = LINEAR_X );
+            const PolarizationType pol      = LINEAR_X,
+            const float_X tabulationError   = 0.0 );
 
     /** Specify your background field E(r,t) here
      *
@@ -131,6 +144,32 @@ public:
     operator()( const DataSpace<simDim>& cellIdx,
                 const uint32_t currentStep ) const;
 
+    /** Update the envelope table of the field for a time step (host only)
+     *
+     * Has no effect if tabulationError <= 0.0. Otherwise the slowly varying
+     * envelope of the complex field is sampled on the local domain at the
+     * begin and end of an interval of time steps and operator() interpolates
+     * it linearly in time while the carrier oscillation is evaluated exactly.
+     * The interval is adapted such that the error at its quarter points and
+     * in its middle stays below tabulationError, the table is resampled when
+     * the moving window slides.
+     *
+     * \param currentStep The current time step
+     * \param totalCellOffset total cell id of the first cell (including the GUARD)
+     *  of the local domain
+     */
+    HINLINE void
+    prepare( const uint32_t currentStep,
+             const DataSpace<simDim>& totalCellOffset );
+
+    /** Allocate the envelope table of the field (host only)
+     *
+     * \return table which must be deleted by the caller after the
+     *  simulation, NULL if tabulationError <= 0.0
+     */
+    HINLINE cellwiseOperation::IBackgroundStorage*
+    createStorage() const;
+
     /** Calculate the Ex(r,t) field here (electric field vector normal to pulse-front-tilt plane)
      *
      * \param pos Spatial position of the target field
@@ -30,6 +30,8 @@
 #include "mappings/simulation/SubGrid.hpp"
 #include "math/Complex.hpp"
 
+#include <stdexcept>
+
 #include "fields/background/templates/TWTS/RotateField.tpp"
 #include "fields/background/templates/TWTS/GetInitialTimeDelay_SI.tpp"
 #include "fields/background/templates/TWTS/getFieldPositions_SI.tpp"
@@ -55,12 +57,14 @@ namespace twts
                     const float_X beta_0,
                     const float_64 tdelay_user_SI,
                     const bool auto_tdelay,
-                    const PolarizationType pol ) :
+                    const PolarizationType pol,
+                    const float_X tabulationError ) :
         focus_y_SI(focus_y_SI), wavelength_SI(wavelength_SI),
         pulselength_SI(pulselength_SI), w_x_SI(w_x_SI),
         w_y_SI(w_y_SI), phi(phi), beta_0(beta_0),
         tdelay_user_SI(tdelay_user_SI), dt(SI::DELTA_T_SI),
-        unit_length(UNIT_LENGTH), auto_tdelay(auto_tdelay), pol(pol)
+        unit_length(UNIT_LENGTH), auto_tdelay(auto_tdelay), pol(pol),
+        tabulationError(tabulationError), quadrature(false)
     {
         /* Note: Enviroment-objects cannot be instantiated on CUDA GPU device. Since this is done
                  on host (see fieldBackground.param), this is no problem.
@@ -176,6 +180,9 @@ namespace twts
     EField::operator()( const DataSpace<simDim>& cellIdx,
                             const uint32_t currentStep ) const
     {
+        if( table.covers(cellIdx, currentStep) )
+            return table(cellIdx, currentStep);
+
         const float_64 time_SI = float_64(currentStep) * dt - tdelay;
 
         const PMacc::math::Vector<floatD_64,detail::numComponents> eFieldPositions_SI =
@@ -328,7 +335,7 @@ namespace twts
             - complex_T(0,2)*z*tanPhi2*tanPhi2;
         const complex_T result = (pmMath::exp(helpVar4)*tauG
             *pmMath::sqrt((cspeed*om0*rho0) / helpVar3)) / pmMath::sqrt(helpVar5);
-        return result.get_real();
+        return ( quadrature ? result.get_imag() : result.get_real() );
     }
 
     /** Calculate the Ey(r,t) field here
@@ -345,6 +352,31 @@ namespace twts
         return calcTWTSEx( pos, time );
     }
 
+    HINLINE void
+    EField::prepare( const uint32_t currentStep,
+                     const DataSpace<simDim>& totalCellOffset )
+    {
+        if( tabulationError <= float_X(0.0) )
+            return;
+
+        FieldTable<EField>* fieldTable = FieldTable<EField>::getInstance();
+        if( fieldTable == NULL )
+            throw std::runtime_error( "TWTS: the field table was not created, see createStorage()" );
+
+        const float_64 omega0_SI = float_64(2.0 * PI) * SI::SPEED_OF_LIGHT_SI / wavelength_SI;
+        table = fieldTable->update( *this, currentStep, totalCellOffset,
+                                    tabulationError, omega0_SI );
+    }
+
+    HINLINE cellwiseOperation::IBackgroundStorage*
+    EField::createStorage() const
+    {
+        if( tabulationError <= float_X(0.0) )
+            return NULL;
+
+        return new FieldTable<EField>();
+    }
+
 } /* namespace twts */
 } /* namespace templates */
 } /* namespace picongpu */
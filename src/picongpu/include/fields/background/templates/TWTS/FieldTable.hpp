@@ -0,0 +1,511 @@
+/**
+ * Copyright 2026 agent
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "types.h"
+
+#include "math/Vector.hpp"
+#include "dimensions/DataSpace.hpp"
+#include "dimensions/DataSpaceOperations.hpp"
+#include "memory/boxes/DataBox.hpp"
+#include "memory/boxes/PitchedBox.hpp"
+#include "memory/buffers/GridBuffer.hpp"
+#include "mappings/simulation/SubGrid.hpp"
+#include "mpi/MPIReduce.hpp"
+#include "nvidia/functors/Max.hpp"
+#include "simulationControl/TimeInterval.hpp"
+#include "debug/PIConGPUVerbose.hpp"
+#include "fields/background/IBackgroundStorage.hpp"
+
+#include <stdexcept>
+
+namespace picongpu
+{
+/* Load pre-defined background field */
+namespace templates
+{
+/* Traveling-wave Thomson scattering laser pulse */
+namespace twts
+{
+    namespace pmMath = PMacc::algorithms::math;
+
+    /** Envelope table of a TWTS field on the local domain (including the GUARD)
+     *
+     * The analytic TWTS field is the real part of a complex field
+     * F(r,t) = A(r,t) * exp(i*omega0*t) with the slowly varying envelope A.
+     * A is sampled at two time steps and linearly interpolated in between,
+     * the carrier exp(i*omega0*t) is applied exactly.
+     * The table is only valid for the time steps [firstStep, firstStep + numSteps]
+     * and the window position it was sampled for.
+     */
+    struct FieldTableBox
+    {
+        typedef DataBox<PitchedBox<float3_X, simDim> > BoxType;
+
+        /* real and imaginary part of the envelope at firstStep (0) and
+         * at firstStep + numSteps (1) */
+        PMACC_ALIGN(re0, BoxType);
+        PMACC_ALIGN(im0, BoxType);
+        PMACC_ALIGN(re1, BoxType);
+        PMACC_ALIGN(im1, BoxType);
+        /* total cell index of the first cell of the table */
+        PMACC_ALIGN(totalCellOffset, DataSpace<simDim>);
+        PMACC_ALIGN(size, DataSpace<simDim>);
+        PMACC_ALIGN(firstStep, uint32_t);
+        PMACC_ALIGN(numSteps, uint32_t);
+        /* carrier phase advance per time step, omega0 * dt */
+        PMACC_ALIGN(phasePerStep, float_64);
+        PMACC_ALIGN(valid, bool);
+
+        HDINLINE FieldTableBox() : firstStep(0), numSteps(0), phasePerStep(0.0), valid(false)
+        {
+        }
+
+        /** carrier phase of a time step, reduced to [0, 2*PI) */
+        HDINLINE float_X
+        getPhase( const uint32_t currentStep ) const
+        {
+            const float_64 phase = phasePerStep * float_64(currentStep);
+            return float_X( phase - 2.0 * PI * pmMath::floor( phase / (2.0 * PI) ) );
+        }
+
+        HDINLINE bool
+        covers( const DataSpace<simDim>& cellIdx, const uint32_t currentStep ) const
+        {
+            if( !valid || currentStep < firstStep || currentStep > firstStep + numSteps )
+                return false;
+            const DataSpace<simDim> localCell( cellIdx - totalCellOffset );
+            for( uint32_t d = 0; d < simDim; ++d )
+                if( localCell[d] < 0 || localCell[d] >= size[d] )
+                    return false;
+            return true;
+        }
+
+        /** field of a cell interpolated from the table, \see covers() */
+        HDINLINE float3_X
+        operator()( const DataSpace<simDim>& cellIdx, const uint32_t currentStep ) const
+        {
+            const DataSpace<simDim> localCell( cellIdx - totalCellOffset );
+            const float_X w = float_X( currentStep - firstStep ) / float_X( numSteps );
+            const float3_X re = ( float_X(1.0) - w ) * re0( localCell ) + w * re1( localCell );
+            const float3_X im = ( float_X(1.0) - w ) * im0( localCell ) + w * im1( localCell );
+            return modulate( re, im, currentStep );
+        }
+
+        /** real part of (re + i*im) * exp(i*phase) */
+        HDINLINE float3_X
+        modulate( const float3_X& re, const float3_X& im, const uint32_t currentStep ) const
+        {
+            const float_X phase = getPhase( currentStep );
+            return re * pmMath::cos( phase ) - im * pmMath::sin( phase );
+        }
+
+        /** envelope (re, im) of a field value and its quadrature */
+        HDINLINE void
+        demodulate( const float3_X& field, const float3_X& quadrature, const uint32_t currentStep,
+                    float3_X& re, float3_X& im ) const
+        {
+            const float_X phase = getPhase( currentStep );
+            const float_X cosPhase = pmMath::cos( phase );
+            const float_X sinPhase = pmMath::sin( phase );
+            re = field * cosPhase + quadrature * sinPhase;
+            im = quadrature * cosPhase - field * sinPhase;
+        }
+    };
+
+    /** Sample the envelope of a TWTS field
+     *
+     * Also compares the interpolation at the quarter points and in the middle
+     * of the interval with the analytic field and sets errorFlag if the
+     * difference exceeds maxError.
+     *
+     * \tparam T_Field EField or BField
+     */
+    struct KernelTabulateTWTS
+    {
+    template<
+        typename T_Acc,
+        typename T_Field>
+    ALPAKA_FN_ACC void operator()(
+        T_Acc const & acc,
+        T_Field const & field,
+        FieldTableBox const & table,
+        int * const errorFlag,
+        float_X const & maxError) const
+    {
+        DataSpace<simDim> const blockIndex(alpaka::idx::getIdx<alpaka::Grid, alpaka::Blocks>(acc));
+        DataSpace<simDim> const threadIndex(alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc));
+
+        const DataSpace<simDim> localCell( blockIndex * SuperCellSize::toRT() + threadIndex );
+        const DataSpace<simDim> totalCell( table.totalCellOffset + localCell );
+
+        /* the quadrature is the imaginary part of the analytic field */
+        T_Field quadrature( field );
+        quadrature.quadrature = true;
+
+        const uint32_t lastStep = table.firstStep + table.numSteps;
+        float3_X re0, im0, re1, im1;
+        table.demodulate( field( totalCell, table.firstStep ), quadrature( totalCell, table.firstStep ),
+                          table.firstStep, re0, im0 );
+        table.demodulate( field( totalCell, lastStep ), quadrature( totalCell, lastStep ),
+                          lastStep, re1, im1 );
+        table.re0( localCell ) = re0;
+        table.im0( localCell ) = im0;
+        table.re1( localCell ) = re1;
+        table.im1( localCell ) = im1;
+
+        /* the error of the linear interpolation is largest in the middle of
+         * the interval only for a slowly varying envelope, also check the
+         * quarter points for pulses which are short against the interval */
+        for( uint32_t quarter = 1u; quarter < 4u; ++quarter )
+        {
+            const uint32_t checkStep = table.firstStep + quarter * table.numSteps / 4u;
+            const float_X w = float_X( checkStep - table.firstStep ) / float_X( table.numSteps );
+            const float3_X interpolated = table.modulate( ( float_X(1.0) - w ) * re0 + w * re1,
+                                                          ( float_X(1.0) - w ) * im0 + w * im1,
+                                                          checkStep );
+            const float3_X error = interpolated - field( totalCell, checkStep );
+            for( uint32_t d = 0; d < 3; ++d )
+                if( pmMath::abs( error[d] ) > maxError )
+                    *errorFlag = 1;
+        }
+    }
+    };
+
+    /** Evaluate a TWTS field on the local domain (including the GUARD)
+     *
+     * Used to measure the runtime and the error of the tabulated field,
+     * \see FieldTable::benchmark(). Each block writes the sum of the absolute
+     * field components of its cells for the time steps
+     * [firstStep, firstStep + numSteps] to blockResult, or the maximal
+     * absolute difference to reference if compare is set.
+     *
+     * \tparam T_Field EField or BField
+     */
+    struct KernelEvaluateTWTS
+    {
+    template<
+        typename T_Acc,
+        typename T_Field>
+    ALPAKA_FN_ACC void operator()(
+        T_Acc const & acc,
+        T_Field const & field,
+        T_Field const & reference,
+        DataSpace<simDim> const & totalCellOffset,
+        uint32_t const firstStep,
+        uint32_t const numSteps,
+        bool const compare,
+        float_X * const blockResult) const
+    {
+        const uint32_t cellsPerSuperCell = PMacc::math::CT::volume<SuperCellSize>::type::value;
+        float_X * const result_sh(alpaka::block::shared::allocArr<float_X, cellsPerSuperCell>(acc));
+
+        DataSpace<simDim> const blockIndex(alpaka::idx::getIdx<alpaka::Grid, alpaka::Blocks>(acc));
+        DataSpace<simDim> const threadIndex(alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc));
+        DataSpace<simDim> const gridBlocks(alpaka::workdiv::getWorkDiv<alpaka::Grid, alpaka::Blocks>(acc));
+
+        const DataSpace<simDim> totalCell( totalCellOffset + blockIndex * SuperCellSize::toRT() + threadIndex );
+
+        float_X result( 0.0 );
+        for( uint32_t step = firstStep; step <= firstStep + numSteps; ++step )
+        {
+            const float3_X value = field( totalCell, step );
+            if( compare )
+            {
+                const float3_X error = value - reference( totalCell, step );
+                for( uint32_t d = 0; d < 3; ++d )
+                    result = pmMath::max( result, pmMath::abs( error[d] ) );
+            }
+            else
+            {
+                for( uint32_t d = 0; d < 3; ++d )
+                    result += pmMath::abs( value[d] );
+            }
+        }
+
+        const int linearThreadIdx = DataSpaceOperations<simDim>::map<SuperCellSize>( threadIndex );
+        result_sh[linearThreadIdx] = result;
+        alpaka::block::sync::syncBlockThreads(acc);
+
+        if( linearThreadIdx == 0 )
+        {
+            for( uint32_t i = 1u; i < cellsPerSuperCell; ++i )
+                result = compare ? pmMath::max( result, result_sh[i] ) : result + result_sh[i];
+            blockResult[DataSpaceOperations<simDim>::map( gridBlocks, blockIndex )] = result;
+        }
+    }
+    };
+
+    /** Host side storage of the envelope table of a TWTS field
+     *
+     * At most one instance per field type, created by createStorage() of the
+     * field before the particle heap is initialized and owned by the
+     * simulation. The table is resampled if the window slides or the time
+     * step leaves the sampled interval. The first table is benchmarked
+     * against the analytic field, \see benchmark().
+     *
+     * \tparam T_Field EField or BField
+     */
+    template<typename T_Field>
+    class FieldTable : public cellwiseOperation::IBackgroundStorage
+    {
+    public:
+
+        /** allocate the table for the local domain (including the GUARD) */
+        HINLINE FieldTable() :
+            numSteps(initialNumSteps), disabled(false), benchmarked(false), slower(false)
+        {
+            if( getInstance() != NULL )
+                throw std::runtime_error( "TWTS: only one field table per field type is allowed" );
+
+            const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
+            box.size = subGrid.getLocalDomain().size + SuperCellSize::toRT() * int(2 * GUARD_SIZE);
+
+            for( uint32_t i = 0; i < 4; ++i )
+                levels[i] = new GridBuffer<float3_X, simDim>( box.size );
+            box.re0 = levels[0]->getDeviceBuffer().getDataBox();
+            box.im0 = levels[1]->getDeviceBuffer().getDataBox();
+            box.re1 = levels[2]->getDeviceBuffer().getDataBox();
+            box.im1 = levels[3]->getDeviceBuffer().getDataBox();
+
+            errorFlag = new GridBuffer<int, DIM1>( DataSpace<DIM1>( 1 ) );
+            const int numBlocks = ( box.size / SuperCellSize::toRT() ).productOfComponents();
+            blockResult = new GridBuffer<float_X, DIM1>( DataSpace<DIM1>( numBlocks ) );
+
+            instance() = this;
+        }
+
+        virtual ~FieldTable()
+        {
+            instance() = NULL;
+
+            for( uint32_t i = 0; i < 4; ++i )
+                __delete(levels[i]);
+            __delete(errorFlag);
+            __delete(blockResult);
+        }
+
+        /** table of the field type, NULL if it was not created */
+        static FieldTable*
+        getInstance()
+        {
+            return instance();
+        }
+
+        /** get a table which covers currentStep
+         *
+         * Must be called by all ranks for the same time steps, the
+         * sampling interval and the fallback to the analytic field are
+         * decided for all ranks together.
+         *
+         * \param field analytic field (its own table is ignored)
+         * \param totalCellOffset total cell index of the first cell (including the GUARD)
+         * \param maxError maximal absolute error of the normalized field
+         * \return table, invalid if the error can not be reached with
+         *         less evaluations than the analytic field until the
+         *         window slides or if the table is slower than the
+         *         analytic field
+         */
+        HINLINE FieldTableBox
+        update( const T_Field& field, const uint32_t currentStep,
+                const DataSpace<simDim>& totalCellOffset, const float_X maxError,
+                const float_64 omega0_SI )
+        {
+            if( box.valid && box.totalCellOffset == totalCellOffset &&
+                currentStep >= box.firstStep && currentStep <= box.firstStep + box.numSteps )
+                return box;
+
+            /* the envelope at the new window position may be smoother */
+            if( disabled && totalCellOffset != disabledCellOffset )
+                disabled = false;
+
+            if( disabled || slower )
+                return FieldTableBox();
+
+            T_Field analyticField( field );
+            analyticField.table.valid = false;
+
+            box.totalCellOffset = totalCellOffset;
+            box.firstStep = currentStep;
+            box.phasePerStep = omega0_SI * SI::DELTA_T_SI;
+            box.valid = false;
+
+            TimeIntervall sampleTime;
+            while( !box.valid )
+            {
+                box.numSteps = numSteps;
+                errorFlag->getDeviceBuffer().setValue( 0 );
+
+                sampleTime.toggleStart();
+                KernelTabulateTWTS kernelTabulateTWTS;
+                __cudaKernel(
+                    kernelTabulateTWTS,
+                    alpaka::dim::DimInt<simDim>,
+                    box.size / SuperCellSize::toRT(),
+                    SuperCellSize::toRT())(
+                        analyticField,
+                        box,
+                        errorFlag->getDeviceBuffer().getBasePointer(),
+                        maxError);
+
+                errorFlag->deviceToHost();
+                sampleTime.toggleEnd();
+                int localError = errorFlag->getHostBuffer().getDataBox()[0];
+                int globalError = 0;
+                mpi::MPIReduce reduce;
+                reduce( nvidia::functors::Max(), &globalError, &localError, 1 );
+
+                if( globalError == 0 )
+                {
+                    box.valid = true;
+                    /* try a longer interval for the next table */
+                    numSteps = PMACC_MIN( 2u * numSteps, maxNumSteps );
+                }
+                else
+                {
+                    numSteps /= 2u;
+                    /* sampling costs seven evaluations of the analytic field per cell */
+                    if( numSteps < minNumSteps )
+                    {
+                        log<picLog::PHYSICS >( "TWTS: tabulation can not reach the requested error, "
+                                               "the field is evaluated analytically until the window slides" );
+                        disabled = true;
+                        disabledCellOffset = totalCellOffset;
+                        return FieldTableBox();
+                    }
+                }
+            }
+
+            if( !benchmarked )
+            {
+                benchmarked = true;
+                benchmark( field, analyticField, sampleTime.getInterval(), maxError );
+                if( slower )
+                    return FieldTableBox();
+            }
+            return box;
+        }
+
+    private:
+
+        /** compare runtime and error of the tabulated and the analytic field
+         *
+         * Evaluates both fields on the local domain for all time steps of the
+         * current table and logs the runtime per time step and the maximal
+         * error. The table is not used for the rest of the simulation if
+         * sampling and interpolating is slower than the analytic field.
+         *
+         * \param sampleTime time to sample the current table in ms
+         */
+        HINLINE void
+        benchmark( const T_Field& field, const T_Field& analyticField,
+                   const double sampleTime, const float_X maxError )
+        {
+            T_Field tabulatedField( field );
+            tabulatedField.table = box;
+
+            double localAnalyticTime = evaluate( analyticField, analyticField, false );
+            double localTabulatedTime = evaluate( tabulatedField, analyticField, false ) + sampleTime;
+            evaluate( tabulatedField, analyticField, true );
+
+            blockResult->deviceToHost();
+            float_X localMaxError( 0.0 );
+            for( int i = 0; i < blockResult->getHostBuffer().getDataSpace().x(); ++i )
+                localMaxError = PMACC_MAX( localMaxError, blockResult->getHostBuffer().getDataBox()[i] );
+
+            /* the slowest rank determines the runtime of a time step */
+            double analyticTime = 0.0;
+            double tabulatedTime = 0.0;
+            float_X globalMaxError( 0.0 );
+            mpi::MPIReduce reduce;
+            reduce( nvidia::functors::Max(), &analyticTime, &localAnalyticTime, 1 );
+            reduce( nvidia::functors::Max(), &tabulatedTime, &localTabulatedTime, 1 );
+            reduce( nvidia::functors::Max(), &globalMaxError, &localMaxError, 1 );
+
+            const double numEvaluatedSteps = double( box.numSteps + 1u );
+            log<picLog::PHYSICS >( "TWTS: analytic field %1% ms per step, tabulated field %2% ms per step "
+                                   "(sampled every %3% steps), maximal error %4% (requested %5%)" ) %
+                ( analyticTime / numEvaluatedSteps ) % ( tabulatedTime / numEvaluatedSteps ) %
+                box.numSteps % globalMaxError % maxError;
+
+            if( tabulatedTime >= analyticTime )
+            {
+                log<picLog::PHYSICS >( "TWTS: tabulation is slower than the analytic field, "
+                                       "the field is evaluated analytically" );
+                slower = true;
+            }
+        }
+
+        /** evaluate a field for all time steps of the table
+         *
+         * \return runtime in ms
+         */
+        HINLINE double
+        evaluate( const T_Field& evaluatedField, const T_Field& reference, const bool compare )
+        {
+            TimeIntervall time;
+            KernelEvaluateTWTS kernelEvaluateTWTS;
+            __cudaKernel(
+                kernelEvaluateTWTS,
+                alpaka::dim::DimInt<simDim>,
+                box.size / SuperCellSize::toRT(),
+                SuperCellSize::toRT())(
+                    evaluatedField,
+                    reference,
+                    box.totalCellOffset,
+                    box.firstStep,
+                    box.numSteps,
+                    compare,
+                    blockResult->getDeviceBuffer().getBasePointer());
+            __getTransactionEvent().waitForFinished();
+            time.toggleEnd();
+            return time.getInterval();
+        }
+
+        static const uint32_t initialNumSteps = 32u;
+        static const uint32_t minNumSteps = 8u;
+        static const uint32_t maxNumSteps = 1024u;
+
+        static FieldTable*&
+        instance()
+        {
+            static FieldTable* ptr = NULL;
+            return ptr;
+        }
+
+        FieldTableBox box;
+        uint32_t numSteps;
+        bool disabled;
+        /* window position at which the requested error was not reached */
+        DataSpace<simDim> disabledCellOffset;
+        bool benchmarked;
+        /* the table is slower than the analytic field */
+        bool slower;
+        GridBuffer<float3_X, simDim>* levels[4];
+        GridBuffer<int, DIM1>* errorFlag;
+        /* per block result of KernelEvaluateTWTS */
+        GridBuffer<float_X, DIM1>* blockResult;
+    };
+
+} /* namespace twts */
+} /* namespace templates */
+} /* namespace picongpu */
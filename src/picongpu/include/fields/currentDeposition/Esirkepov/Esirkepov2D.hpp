@@ -45,6 +45,9 @@ using namespace PMacc;
 template<typename T_ParticleShape>
 struct Esirkepov<T_ParticleShape, DIM2>
 {
+    /* how the current is added to the cache, @see fields/currentDeposition/Solver.def */
+    typedef typename picongpu::traits::GetDepositionStrategy<Esirkepov>::type DepositionStrategy;
+
     typedef typename T_ParticleShape::ChargeAssignment ParticleAssign;
     static const int supp = ParticleAssign::support;
 
@@ -174,7 +177,7 @@ struct Esirkepov<T_ParticleShape, DIM2>
                 accumulated_J += -this->charge * (float_X(1.0) / float_X(CELL_VOLUME * DELTA_T)) * W * cellEdgeLength;
                 /* the branch divergence here still over-compensates for the fewer collisions in the (expensive) atomic adds */
                 if (accumulated_J != float_X(0.0))
-                    alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &((*cursorJ(i, j)).x()), accumulated_J);
+                    DepositionStrategy::add(acc, &((*cursorJ(i, j)).x()), accumulated_J);
             }
         }
 
@@ -210,7 +213,7 @@ struct Esirkepov<T_ParticleShape, DIM2>
 
                 const float_X j_z = this->charge * (float_X(1.0) / float_X(CELL_VOLUME)) * W * v_z;
                 if (j_z != float_X(0.0))
-                    alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &((*cursorJ(i, j)).z()), j_z);
+                    DepositionStrategy::add(acc, &((*cursorJ(i, j)).z()), j_z);
             }
         }
 
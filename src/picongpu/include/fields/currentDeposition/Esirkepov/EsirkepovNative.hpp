@@ -46,6 +46,9 @@ using namespace PMacc;
 template<typename T_ParticleShape>
 struct EsirkepovNative
 {
+    /* how the current is added to the cache, @see fields/currentDeposition/Solver.def */
+    typedef typename picongpu::traits::GetDepositionStrategy<EsirkepovNative>::type DepositionStrategy;
+
     typedef typename T_ParticleShape::ChargeAssignment ParticleAssign;
     static const int supp = ParticleAssign::support;
 
@@ -135,7 +138,7 @@ struct EsirkepovNative
                     /* We multiply with `cellEdgeLength` due to the fact that the attribute for the
                      * in-cell particle `position` (and it's change in DELTA_T) is normalize to [0,1) */
                     accumulated_J += -this->charge * (float_X(1.0) / float_X(CELL_VOLUME * DELTA_T)) * W * cellEdgeLength;
-                    alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &((*cursorJ(i, j, k)).z()), accumulated_J);
+                    DepositionStrategy::add(acc, &((*cursorJ(i, j, k)).z()), accumulated_J);
                 }
             }
         }
@@ -38,6 +38,9 @@ using namespace PMacc;
 template<typename T_ParticleShape>
 struct VillaBune
 {
+    /* how the current is added to the cache, @see fields/currentDeposition/Solver.def */
+    typedef typename picongpu::traits::GetDepositionStrategy<VillaBune>::type DepositionStrategy;
+
     template<
         typename T_Acc,
         typename BoxJ,
@@ -154,20 +157,20 @@ private:
         const float_X rho_dtY = charge * (float_X(1.0) / (CELL_WIDTH * CELL_DEPTH * deltaTime));
         const float_X rho_dtZ = charge * (float_X(1.0) / (CELL_WIDTH * CELL_HEIGHT * deltaTime));
 
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(mem[1][1][0].x()), rho_dtX * (deltaPos.x() * meanPos.y() * meanPos.z() + tmp));
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(mem[1][0][0].x()), rho_dtX * (deltaPos.x() * (float_X(1.0) - meanPos.y()) * meanPos.z() - tmp));
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(mem[0][1][0].x()), rho_dtX * (deltaPos.x() * meanPos.y() * (float_X(1.0) - meanPos.z()) - tmp));
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(mem[0][0][0].x()), rho_dtX * (deltaPos.x() * (float_X(1.0) - meanPos.y()) * (float_X(1.0) - meanPos.z()) + tmp));
+        DepositionStrategy::add(acc, &(mem[1][1][0].x()), rho_dtX * (deltaPos.x() * meanPos.y() * meanPos.z() + tmp));
+        DepositionStrategy::add(acc, &(mem[1][0][0].x()), rho_dtX * (deltaPos.x() * (float_X(1.0) - meanPos.y()) * meanPos.z() - tmp));
+        DepositionStrategy::add(acc, &(mem[0][1][0].x()), rho_dtX * (deltaPos.x() * meanPos.y() * (float_X(1.0) - meanPos.z()) - tmp));
+        DepositionStrategy::add(acc, &(mem[0][0][0].x()), rho_dtX * (deltaPos.x() * (float_X(1.0) - meanPos.y()) * (float_X(1.0) - meanPos.z()) + tmp));
 
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(mem[1][0][1].y()), rho_dtY * (deltaPos.y() * meanPos.z() * meanPos.x() + tmp));
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(mem[0][0][1].y()), rho_dtY * (deltaPos.y() * (float_X(1.0) - meanPos.z()) * meanPos.x() - tmp));
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(mem[1][0][0].y()), rho_dtY * (deltaPos.y() * meanPos.z() * (float_X(1.0) - meanPos.x()) - tmp));
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(mem[0][0][0].y()), rho_dtY * (deltaPos.y() * (float_X(1.0) - meanPos.z()) * (float_X(1.0) - meanPos.x()) + tmp));
+        DepositionStrategy::add(acc, &(mem[1][0][1].y()), rho_dtY * (deltaPos.y() * meanPos.z() * meanPos.x() + tmp));
+        DepositionStrategy::add(acc, &(mem[0][0][1].y()), rho_dtY * (deltaPos.y() * (float_X(1.0) - meanPos.z()) * meanPos.x() - tmp));
+        DepositionStrategy::add(acc, &(mem[1][0][0].y()), rho_dtY * (deltaPos.y() * meanPos.z() * (float_X(1.0) - meanPos.x()) - tmp));
+        DepositionStrategy::add(acc, &(mem[0][0][0].y()), rho_dtY * (deltaPos.y() * (float_X(1.0) - meanPos.z()) * (float_X(1.0) - meanPos.x()) + tmp));
 
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(mem[0][1][1].z()), rho_dtZ * (deltaPos.z() * meanPos.x() * meanPos.y() + tmp));
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(mem[0][1][0].z()), rho_dtZ * (deltaPos.z() * (float_X(1.0) - meanPos.x()) * meanPos.y() - tmp));
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(mem[0][0][1].z()), rho_dtZ * (deltaPos.z() * meanPos.x() * (float_X(1.0) - meanPos.y()) - tmp));
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(mem[0][0][0].z()), rho_dtZ * (deltaPos.z() * (float_X(1.0) - meanPos.x()) * (float_X(1.0) - meanPos.y()) + tmp));
+        DepositionStrategy::add(acc, &(mem[0][1][1].z()), rho_dtZ * (deltaPos.z() * meanPos.x() * meanPos.y() + tmp));
+        DepositionStrategy::add(acc, &(mem[0][1][0].z()), rho_dtZ * (deltaPos.z() * (float_X(1.0) - meanPos.x()) * meanPos.y() - tmp));
+        DepositionStrategy::add(acc, &(mem[0][0][1].z()), rho_dtZ * (deltaPos.z() * meanPos.x() * (float_X(1.0) - meanPos.y()) - tmp));
+        DepositionStrategy::add(acc, &(mem[0][0][0].z()), rho_dtZ * (deltaPos.z() * (float_X(1.0) - meanPos.x()) * (float_X(1.0) - meanPos.y()) + tmp));
 
     }
 
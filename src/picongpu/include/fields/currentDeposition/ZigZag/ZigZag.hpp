@@ -93,8 +93,9 @@ struct EvalAssignmentFunctionOfDirection
  * @tparam T_GridPointVec integral type which define grid point
  * @tparam T_Shape assignment shape of the particle
  * @tparam T_CurrentComponent integral type with component information
+ * @tparam T_DepositionStrategy how the current is added, @see Strategy.def
  */
-template<typename T_GridPointVec, typename T_Shape, typename T_CurrentComponent>
+template<typename T_GridPointVec, typename T_Shape, typename T_CurrentComponent, typename T_DepositionStrategy>
 struct AssignChargeToCell
 {
 
@@ -130,7 +131,7 @@ struct AssignChargeToCell
         /* shift memory cursor to cell (grid point)*/
         PMACC_AUTO(cursorToValue, cursor(GridPointVec::toRT()));
         /* add current to component of the cell*/
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &((*cursorToValue)[currentComponent]), j);
+        T_DepositionStrategy::add(acc, &((*cursorToValue)[currentComponent]), j);
     }
 };
 
@@ -141,6 +142,9 @@ struct AssignChargeToCell
 template<typename T_ParticleShape>
 struct ZigZag
 {
+    /* how the current is added to the cache, @see fields/currentDeposition/Solver.def */
+    typedef typename picongpu::traits::GetDepositionStrategy<ZigZag>::type DepositionStrategy;
+
     /* cloud shape: describe the form factor of a particle
      * assignment shape: integral over the cloud shape (this shape is defined by the user in
      * species.param for a species)
@@ -218,7 +222,7 @@ struct ZigZag
 
             /* calculate the current for every cell (grid point)*/
             typedef typename AllCombinations<Size>::type CombiTypes;
-            ForEach<CombiTypes, AssignChargeToCell<bmpl::_1, ParticleShape, CurrentComponent > > callAssignChargeToCell;
+            ForEach<CombiTypes, AssignChargeToCell<bmpl::_1, ParticleShape, CurrentComponent, DepositionStrategy > > callAssignChargeToCell;
             callAssignChargeToCell(acc,forward(cursor), pos, flux[dir]);
         }
 
@@ -30,6 +30,7 @@ MallocMCBuffer::MallocMCBuffer( ) :
     upBufHost(),
     hostBufferOffset(0)
 {
+#ifndef PMACC_ACC_CPU
     /* currently mallocMC has only one heap */
     this->deviceHeapInfo=mallocMC::getHeapLocations()[0];
 
@@ -38,6 +39,7 @@ MallocMCBuffer::MallocMCBuffer( ) :
             reinterpret_cast<char *>(deviceHeapInfo.p),
             Environment<>::get().DeviceManager().getAccDevice(),
             static_cast<AlpakaSize>(deviceHeapInfo.size)));
+#endif
 
     Environment<>::get().DataConnector().registerData( *this);
 }
@@ -49,6 +51,15 @@ MallocMCBuffer::~MallocMCBuffer( )
 
 void MallocMCBuffer::synchronize( )
 {
+#ifdef PMACC_ACC_CPU
+    /* host and accelerator share the address space: the heap is used
+     * in place (hostBufferOffset stays zero), we only wait until all
+     * kernels which could change frames are finished
+     */
+    __startOperation(ITask::TASK_CUDA);
+    __startOperation(ITask::TASK_HOST);
+    Environment<>::get().StreamController().waitForAll();
+#else
     /** \todo: we had no abstraction to create a host buffer and a pseudo
      *         device buffer (out of the mallocMC ptr) and copy both with our event
      *         system.
@@ -75,13 +86,14 @@ void MallocMCBuffer::synchronize( )
     __startOperation(ITask::TASK_CUDA);
     __startOperation(ITask::TASK_HOST);
 
-    AlpakaAccStream stream(Environment<>::get().DeviceManager().getAccDevice());
+    AlpakaAccStreamSync stream(Environment<>::get().DeviceManager().getAccDevice());
     alpaka::mem::view::copy(
         stream,
         *upBufHost.get(),
         *upBufWrapperDev.get(),
         deviceHeapInfo.size);
     alpaka::wait::wait(stream);
+#endif
 }
 
 } //namespace picongpu
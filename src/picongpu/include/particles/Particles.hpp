@@ -56,7 +56,14 @@ public:
 
     void init(FieldE &fieldE, FieldB &fieldB, FieldJ &fieldJ, FieldTmp &fieldTmp);
 
-    void update(uint32_t currentStep);
+    /* push the particles in BORDER and move the particles which leave the
+     * local domain to the GUARD, afterwards the GUARD can be sent with
+     * asyncSendParticles() while updateCore() is running */
+    void updateBorder(uint32_t currentStep);
+
+    /* push the particles in CORE and finish the shift, call after
+     * updateBorder(), particles can be received afterwards */
+    void updateCore(uint32_t currentStep);
 
     template<typename T_GasFunctor, typename T_PositionFunctor>
     void initGas(T_GasFunctor& gasFunctor, T_PositionFunctor& positionFunctor, const uint32_t currentStep);
@@ -81,6 +88,9 @@ public:
     void syncToDevice();
 
 private:
+    /* push the particles of all supercells of a mapping */
+    void push(uint32_t currentStep, typename ParticlesBaseType::ActiveSuperCellMapping areaMapper);
+
     SimulationDataId datasetID;
     GridLayout<simDim> gridLayout;
 
@@ -37,7 +37,9 @@
 #include "fields/FieldB.hpp"
 #include "fields/FieldE.hpp"
 #include "fields/FieldJ.hpp"
+#include "fields/FieldJ.kernel"
 #include "fields/FieldTmp.hpp"
+#include "fields/background/BackgroundFieldBox.hpp"
 
 #include "particles/memory/buffers/ParticlesBuffer.hpp"
 #include "ParticlesInit.kernel"
@@ -67,46 +69,51 @@ fieldB( NULL ), fieldE( NULL ), fieldJurrent( NULL ), fieldTmp( NULL ), gridLayo
 datasetID( datasetID )
 {
     size_t sizeOfExchanges = 2 * 2 * ( BYTES_EXCHANGE_X + BYTES_EXCHANGE_Y + BYTES_EXCHANGE_Z ) + BYTES_EXCHANGE_X * 2 * 8;
+    /* exchanges start with the minimal size and grow with the traffic */
+    const size_t minExchange = EXCHANGE_ADAPT_PERIOD != 0 ? BYTES_EXCHANGE_MIN : 0;
 
 
     this->particlesBuffer = new BufferType( gridLayout.getDataSpace( ), gridLayout.getGuard( ) );
 
-    log<picLog::MEMORY > ( "size for all exchange = %1% MiB" ) % ( (double) sizeOfExchanges / 1024. / 1024. );
+    log<picLog::MEMORY > ( "maximal size for all exchange = %1% MiB" ) % ( (double) sizeOfExchanges / 1024. / 1024. );
 
     const uint32_t commTag = FrameType::CommunicationTag + SPECIES_FIRSTTAG;
     this->particlesBuffer->addExchange( Mask( LEFT ) + Mask( RIGHT ),
                                         BYTES_EXCHANGE_X,
-                                        commTag);
+                                        commTag, minExchange);
     this->particlesBuffer->addExchange( Mask( TOP ) + Mask( BOTTOM ),
                                         BYTES_EXCHANGE_Y,
-                                        commTag);
+                                        commTag, minExchange);
     //edges of the simulation area
     this->particlesBuffer->addExchange( Mask( RIGHT + TOP ) + Mask( LEFT + TOP ) +
                                         Mask( LEFT + BOTTOM ) + Mask( RIGHT + BOTTOM ), BYTES_EDGES,
-                                        commTag);
+                                        commTag, minExchange);
 
 #if(SIMDIM==DIM3)
     this->particlesBuffer->addExchange( Mask( FRONT ) + Mask( BACK ), BYTES_EXCHANGE_Z,
-                                        commTag);
+                                        commTag, minExchange);
     //edges of the simulation area
     this->particlesBuffer->addExchange( Mask( FRONT + TOP ) + Mask( BACK + TOP ) +
                                         Mask( FRONT + BOTTOM ) + Mask( BACK + BOTTOM ),
                                         BYTES_EDGES,
-                                        commTag);
+                                        commTag, minExchange);
     this->particlesBuffer->addExchange( Mask( FRONT + RIGHT ) + Mask( BACK + RIGHT ) +
                                         Mask( FRONT + LEFT ) + Mask( BACK + LEFT ),
                                         BYTES_EDGES,
-                                        commTag);
+                                        commTag, minExchange);
     //corner of the simulation area
     this->particlesBuffer->addExchange( Mask( TOP + FRONT + RIGHT ) + Mask( TOP + BACK + RIGHT ) +
                                         Mask( BOTTOM + FRONT + RIGHT ) + Mask( BOTTOM + BACK + RIGHT ),
                                         BYTES_CORNER,
-                                        commTag);
+                                        commTag, minExchange);
     this->particlesBuffer->addExchange( Mask( TOP + FRONT + LEFT ) + Mask( TOP + BACK + LEFT ) +
                                         Mask( BOTTOM + FRONT + LEFT ) + Mask( BOTTOM + BACK + LEFT ),
                                         BYTES_CORNER,
-                                        commTag);
+                                        commTag, minExchange);
 #endif
+
+    if( EXCHANGE_ADAPT_PERIOD != 0 )
+        this->particlesBuffer->setExchangeGrowthBudget( BYTES_EXCHANGE_GROWTH );
 }
 
 template< typename T_ParticleDescription>
@@ -151,7 +158,8 @@ void Particles<T_ParticleDescription>::init( FieldE &fieldE, FieldB &fieldB, Fie
 }
 
 template<typename T_ParticleDescription>
-void Particles<T_ParticleDescription>::update(uint32_t )
+void Particles<T_ParticleDescription>::push(uint32_t currentStep,
+                                           typename ParticlesBaseType::ActiveSuperCellMapping areaMapper)
 {
     typedef typename HasFlag<FrameType,particlePusher<> >::type hasPusher;
     typedef typename GetFlagType<FrameType,particlePusher<> >::type FoundPusher;
@@ -179,19 +187,78 @@ void Particles<T_ParticleDescription>::update(uint32_t )
 
     DataSpace<simDim> block( MappingDesc::SuperCellSize::toRT() );
 
+    /* background fields for the pusher are added while the fields are cached */
+    typedef cellwiseOperation::GetPusherFieldBox<FieldE, FieldBackgroundE> GetEBox;
+    typedef cellwiseOperation::GetPusherFieldBox<FieldB, FieldBackgroundB> GetBBox;
+
+#if (ENABLE_CURRENT == 1) && (ENABLE_FUSED_CURRENT == 1)
+    typedef typename PMacc::traits::Resolve<
+        typename GetFlagType<FrameType, current<> >::type
+        >::type ParticleCurrentSolver;
+
+    typedef ComputeCurrentPerParticle<ParticleCurrentSolver, Velocity> CurrentSolver;
+
+    /* a pushed particle is not shifted yet and can be one cell outside of its supercell */
+    typedef typename PMacc::math::CT::make_Int<simDim, 1>::type OneCell;
+    typedef SuperCellDescription<
+        typename MappingDesc::SuperCellSize,
+        typename PMacc::math::CT::add<typename GetMargin<ParticleCurrentSolver>::LowerMargin, OneCell>::type,
+        typename PMacc::math::CT::add<typename GetMargin<ParticleCurrentSolver>::UpperMargin, OneCell>::type
+        > BlockAreaJ;
+
+    /* the mapping must be split into the colors of a stride mapping that
+     * the current of two blocks never overlaps
+     */
+    do
+    {
+        KernelMoveAndMarkAndDepositParticles<BlockArea, BlockAreaJ> kernelMoveAndMarkAndDepositParticles;
+        __picKernelMapperElements(
+            kernelMoveAndMarkAndDepositParticles,
+            alpaka::dim::DimInt<simDim>,
+            areaMapper,
+            block)(
+                this->getDeviceParticlesBox( ),
+                GetEBox::get( *(this->fieldE), currentStep ),
+                GetBBox::get( *(this->fieldB), currentStep ),
+                this->fieldJurrent->getDeviceDataBox( ),
+                FrameSolver( ),
+                CurrentSolver( DELTA_T ));
+    }
+    while( areaMapper.next( ) );
+#else
     KernelMoveAndMarkParticles<BlockArea> kernelMoveAndMarkParticles;
-    __picKernelArea(
+    __picKernelMapperElements(
         kernelMoveAndMarkParticles,
         alpaka::dim::DimInt<simDim>,
-        this->cellDescription,
-        CORE + BORDER,
+        areaMapper,
         block)(
             this->getDeviceParticlesBox( ),
-            this->fieldE->getDeviceDataBox( ),
-            this->fieldB->getDeviceDataBox( ),
+            GetEBox::get( *(this->fieldE), currentStep ),
+            GetBBox::get( *(this->fieldB), currentStep ),
             FrameSolver( ));
+#endif
+}
+
+template<typename T_ParticleDescription>
+void Particles<T_ParticleDescription>::updateBorder(uint32_t currentStep)
+{
+#if (ENABLE_CURRENT == 1) && (ENABLE_FUSED_CURRENT == 1)
+    /* the colors of the active supercells are not split into BORDER and CORE,
+     * all particles are pushed before the exchange */
+    push( currentStep, this->getActiveSuperCellStrideMapping( ) );
+#else
+    push( currentStep, this->getActiveBorderSuperCellMapping( ) );
+#endif
+    ParticlesBaseType::shiftBorderParticles( );
+}
 
-    ParticlesBaseType::template shiftParticles < CORE + BORDER > ( );
+template<typename T_ParticleDescription>
+void Particles<T_ParticleDescription>::updateCore(uint32_t currentStep)
+{
+#if (ENABLE_CURRENT != 1) || (ENABLE_FUSED_CURRENT != 1)
+    push( currentStep, this->getActiveCoreSuperCellMapping( ) );
+#endif
+    ParticlesBaseType::shiftCoreParticles( FRAME_COMPACTION_THRESHOLD );
 }
 
 template< typename T_ParticleDescription>
@@ -86,10 +86,19 @@ struct CallCreateParticleBuffer
 
         typedef typename SpeciesType::FrameType FrameType;
 
+#if (PMACC_FRAME_POOL == 1)
+        typedef typename PMacc::FramePoolBox<FrameType> FramePoolBoxType;
+        log<picLog::MEMORY >("mallocMC: free slabs for species %3%: %1% a %2% (%4% frames per slab)") %
+            mallocMC::getAvailableSlots(FramePoolBoxType::slabBytes) %
+            FramePoolBoxType::slabBytes %
+            FrameType::getName() %
+            FramePoolBoxType::framesPerSlab;
+#else
         log<picLog::MEMORY >("mallocMC: free slots for species %3%: %1% a %2%") %
             mallocMC::getAvailableSlots(sizeof (FrameType)) %
             sizeof (FrameType) %
             FrameType::getName();
+#endif
 
         tuple[SpeciesName()]->createParticleBuffer();
     }
@@ -148,13 +157,28 @@ struct CallUpdate
             PMACC_AUTO(speciesPtr, tuple[SpeciesName()]);
 
             __startTransaction(eventInt);
-            speciesPtr->update(currentStep);
-            commEvent += speciesPtr->asyncCommunication(__getTransactionEvent());
+            /* particles leaving the local domain are sent while CORE is pushed */
+            speciesPtr->updateBorder(currentStep);
+            commEvent += speciesPtr->asyncSendParticles(__getTransactionEvent());
+            speciesPtr->updateCore(currentStep);
+            commEvent += speciesPtr->asyncReceiveParticles(__getTransactionEvent());
             updateEvent += __endTransaction();
         }
     }
 };
 
+template<typename T_SpeciesName>
+struct CallAdaptExchangeBuffers
+{
+    typedef T_SpeciesName SpeciesName;
+
+    template<typename T_StorageTuple>
+    HINLINE void operator()(T_StorageTuple& tuple) const
+    {
+        tuple[SpeciesName()]->adaptExchangeBuffers();
+    }
+};
+
 /** \struct CallIonization
  * 
  * \brief Tests if species can be ionized and calls the kernel to do that
@@ -208,15 +232,14 @@ struct CallIonization
              *        while cycling through the particle frames
              *
              * kernel call : instead of name<<<blocks, threads>>> (args, ...)
-             * "blocks" will be calculated from "this->cellDescription" and "CORE + BORDER"
+             * "blocks" are the supercells of CORE + BORDER which contain ions
              * "threads" is calculated from the previously defined vector "block"
              */
             particles::ionization::KernelIonizeParticles kernelIonizeParticles;
-            __picKernelArea(
+            __picKernelMapper(
                 kernelIonizeParticles,
                 alpaka::dim::DimInt<simDim>,
-                *cellDesc,
-                CORE + BORDER,
+                srcSpeciesPtr->getActiveSuperCellMapping( ),
                 block)(
                     srcSpeciesPtr->getDeviceParticlesBox( ),
                     electronsPtr->getDeviceParticlesBox( ),
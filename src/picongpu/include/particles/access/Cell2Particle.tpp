@@ -61,7 +61,8 @@ BOOST_PP_ENUM_TRAILING(N, NORMAL_ARGS, _)) \
     \
     while (isValid) \
     { \
-        if (linearThreadIdx < particlesInSuperCell) \
+        if (linearThreadIdx < particlesInSuperCell && \
+            (*frame)[linearThreadIdx][multiMask_] == 1) /* skip gaps */ \
         { \
             functor( \
                 frame, linearThreadIdx \
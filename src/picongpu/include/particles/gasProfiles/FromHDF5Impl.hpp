@@ -27,6 +27,7 @@
 #include "simulationControl/MovingWindow.hpp"
 #include "fields/Fields.hpp"
 #include "dataManagement/DataConnector.hpp"
+#include "plugins/hdf5/SplashLock.hpp"
 
 namespace picongpu
 {
@@ -82,6 +83,9 @@ private:
         const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(0);
         const uint32_t maxOpenFilesPerNode = 1;
 
+        /* gas is also created after a slide, serialize with the asynchronous HDF5 output */
+        std::lock_guard<std::mutex> lock(hdf5::splashMutex());
+
         /* get a new ParallelDomainCollector for our MPI rank only*/
         ParallelDomainCollector pdc(
                                     MPI_COMM_SELF,
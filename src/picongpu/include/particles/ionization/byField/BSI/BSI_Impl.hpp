@@ -28,6 +28,7 @@
 
 #include "fields/FieldB.hpp"
 #include "fields/FieldE.hpp"
+#include "fields/background/BackgroundFieldBox.hpp"
 
 #include "particles/ionization/byField/BSI/BSI.def"
 #include "particles/ionization/byField/BSI/AlgorithmBSI.hpp"
@@ -87,25 +88,23 @@ namespace ionization
 
             typedef FieldE::ValueType ValueType_E;
             typedef FieldB::ValueType ValueType_B;
-            /* global memory EM-field device databoxes */
-            FieldE::DataBoxType eBox;
-            FieldB::DataBoxType bBox;
+            /* global memory EM-field device databoxes, including the
+             * background fields which influence the particles */
+            typedef cellwiseOperation::GetPusherFieldBox<FieldE, FieldBackgroundE> GetEBox;
+            typedef cellwiseOperation::GetPusherFieldBox<FieldB, FieldBackgroundB> GetBBox;
+            typename GetEBox::type eBox;
+            typename GetBBox::type bBox;
             /* shared memory EM-field device databoxes */
             PMACC_ALIGN(cachedE, DataBox<SharedBox<ValueType_E, typename BlockArea::FullSuperCellSize,1> >);
             PMACC_ALIGN(cachedB, DataBox<SharedBox<ValueType_B, typename BlockArea::FullSuperCellSize,0> >);
 
         public:
             /* host constructor */
-            BSI_Impl(const uint32_t currentStep)
-            {
-                DataConnector &dc = Environment<>::get().DataConnector();
-                /* initialize pointers on host-side E-(B-)field databoxes */
-                FieldE* fieldE = &(dc.getData<FieldE > (FieldE::getName(), true));
-                FieldB* fieldB = &(dc.getData<FieldB > (FieldB::getName(), true));
+            BSI_Impl(const uint32_t currentStep) :
                 /* initialize device-side E-(B-)field databoxes */
-                eBox = fieldE->getDeviceDataBox();
-                bBox = fieldB->getDeviceDataBox();
-
+                eBox(GetEBox::get(Environment<>::get().DataConnector().getData<FieldE > (FieldE::getName(), true), currentStep)),
+                bBox(GetBBox::get(Environment<>::get().DataConnector().getData<FieldB > (FieldB::getName(), true), currentStep))
+            {
             }
 
             /** Initialization function on device
@@ -27,6 +27,7 @@
 #include "simulation_defines.hpp"
 #include "particles/Particles.hpp"
 #include "mappings/kernel/AreaMapping.hpp"
+#include "mappings/kernel/ListMapping.hpp"
 #include "particles/ParticlesInit.kernel"
 #include "mappings/simulation/GridController.hpp"
 #include "simulationControl/MovingWindow.hpp"
@@ -106,215 +107,212 @@ ALPAKA_FN_ACC void operator()(
     /* 3D vector from origin of the block to a cell in units of cells */
     DataSpace<simDim> const threadIndex(alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc));
 
-    /* "offset" 3D distance to origin in units of super cells */
-    const DataSpace<simDim> block(mapper.getSuperCellIndex(DataSpace<simDim > (blockIndex)));
-
     /* conversion from a 3D cell coordinate to a linear coordinate of the cell in its super cell */
     const int linearThreadIdx = DataSpaceOperations<simDim>::template map<SuperCellSize > (threadIndex);
 
-    /* "offset" from origin of the grid in unit of cells */
-    const DataSpace<simDim> blockCell = block * SuperCellSize::toRT();
-
-    /* subtract guarding cells to only have the simulation volume */
-    const DataSpace<simDim> localCellIndex = (block * SuperCellSize::toRT() + threadIndex) - mapper.getGuardingSuperCells() * SuperCellSize::toRT();
-
     /* typedef for the functor that writes new macro electrons into electron frames during runtime */
     typedef typename particles::ionization::WriteElectronIntoFrame WriteElectronIntoFrame;
 
-    alpaka::block::sync::syncBlockThreads(acc);
-
     auto ionFrame(alpaka::block::shared::allocVar<IONFRAME *>(acc));
     auto electronFrame(alpaka::block::shared::allocVar<ELECTRONFRAME *>(acc));
     auto isValid(alpaka::block::shared::allocVar<bool>(acc));
     auto maxParticlesInFrame(alpaka::block::shared::allocVar<lcellId_t>(acc));
 
-    alpaka::block::sync::syncBlockThreads(acc); /*wait that all shared memory is initialized*/
-
-    /* find last frame in super cell
-     * define maxParticlesInFrame as the maximum frame size
-     */
-    if (linearThreadIdx == 0)
-    {
-        ionFrame = &(ionBox.getLastFrame(block, isValid));
-        maxParticlesInFrame = PMacc::math::CT::volume<SuperCellSize>::type::value;
-    }
-
-    alpaka::block::sync::syncBlockThreads(acc);
-    if (!isValid)
-        return; //end kernel if we have no frames
-
-    /* caching of E- and B- fields and initialization of random generator if needed */
-    frameIonizer.init(blockCell, linearThreadIdx, localCellIndex);
-
     /* Declare counter in shared memory that will later tell the current fill level or
      * occupation of the newly created target electron frames.
      */
     auto newFrameFillLvl(alpaka::block::shared::allocVar<int>(acc));
 
-    alpaka::block::sync::syncBlockThreads(acc); /*wait until all shared memory is initialized*/
+    alpaka::block::sync::syncBlockThreads(acc); /*wait that all shared memory is initialized*/
 
-    /* Declare local variable oldFrameFillLvl for each thread */
-    int oldFrameFillLvl;
+    /* "block" is the 3D distance to origin in units of super cells */
+    forEachMappedSuperCell(acc, mapper, blockIndex, [&](DataSpace<simDim> const & block)
+    {
+        /* "offset" from origin of the grid in unit of cells */
+        const DataSpace<simDim> blockCell = block * SuperCellSize::toRT();
 
-    /* Initialize local (register) counter for each thread
-     * - describes how many new macro electrons should be created
-     */
-    unsigned int newMacroElectrons = 0;
+        /* subtract guarding cells to only have the simulation volume */
+        const DataSpace<simDim> localCellIndex = (block * SuperCellSize::toRT() + threadIndex) - mapper.getGuardingSuperCells() * SuperCellSize::toRT();
 
-    /* Declare local electron ID
-     * - describes at which position in the new frame the new electron is to be created
-     */
-    int electronId;
+        /* find last frame in super cell
+         * define maxParticlesInFrame as the maximum frame size
+         */
+        if (linearThreadIdx == 0)
+        {
+            ionFrame = &(ionBox.getLastFrame(block, isValid));
+            maxParticlesInFrame = PMacc::math::CT::volume<SuperCellSize>::type::value;
+        }
 
-    /* Master initializes the frame fill level with 0 */
-    if (linearThreadIdx == 0)
-    {
-        newFrameFillLvl = 0;
-        electronFrame = NULL;
-    }
-    alpaka::block::sync::syncBlockThreads(acc);
-
-    /* move over source species frames and call frameIonizer
-     * frames are worked on in backwards order to avoid asking if there is another frame
-     * --> performance
-     * Because all frames are completely filled except the last and apart from that last frame
-     * one wants to make sure that all threads are working and every frame is worked on.
-     */
-    while (isValid)
-    {
-        /* casting uint8_t multiMask to boolean */
-        const bool isParticle = (*ionFrame)[linearThreadIdx][multiMask_];
         alpaka::block::sync::syncBlockThreads(acc);
+        if (!isValid)
+            return; //end supercell if we have no frames
+
+        /* caching of E- and B- fields and initialization of random generator if needed */
+        frameIonizer.init(blockCell, linearThreadIdx, localCellIndex);
+
+        /* Declare local variable oldFrameFillLvl for each thread */
+        int oldFrameFillLvl;
+
+        /* Initialize local (register) counter for each thread
+         * - describes how many new macro electrons should be created
+         */
+        unsigned int newMacroElectrons = 0;
 
-        /* < IONIZATION and change of charge states >
-         * if the threads contain particles, the frameIonizer can ionize them
-         * if they are non-particles their inner ionization counter remains at 0
+        /* Declare local electron ID
+         * - describes at which position in the new frame the new electron is to be created
          */
-        if (isParticle)
-            /* ionization based on ionization model - this actually increases charge states*/
-            frameIonizer(*ionFrame, linearThreadIdx, newMacroElectrons);
+        int electronId;
 
+        /* Master initializes the frame fill level with 0 */
+        if (linearThreadIdx == 0)
+        {
+            newFrameFillLvl = 0;
+            electronFrame = NULL;
+        }
         alpaka::block::sync::syncBlockThreads(acc);
-        /* always true while-loop over all particles inside source frame until each thread breaks out individually
-         *
-         * **Attention**: Speaking of 1st and 2nd frame only may seem odd.
-         * The question might arise what happens if more electrons are created than would fit into two frames.
-         * Well, multi-ionization during a time step is accounted for. The number of new electrons is
-         * determined inside the outer loop over the valid frames while in the inner loop each thread can create only ONE
-         * new macro electron. But the loop repeats until each thread has created all the electrons needed in the time step.
+
+        /* move over source species frames and call frameIonizer
+         * frames are worked on in backwards order to avoid asking if there is another frame
+         * --> performance
+         * Because all frames are completely filled except the last and apart from that last frame
+         * one wants to make sure that all threads are working and every frame is worked on.
          */
-        while (true)
+        while (isValid)
         {
-            /* < INIT >
-             * - electronId is initialized as -1 (meaning: invalid)
-             * - (local) oldFrameFillLvl set equal to (shared) newFrameFillLvl for each thread
-             * --> each thread remembers the old "counter"
-             * - then sync
-             */
-            electronId = -1;
-            oldFrameFillLvl = newFrameFillLvl;
+            /* casting uint8_t multiMask to boolean */
+            const bool isParticle = (*ionFrame)[linearThreadIdx][multiMask_];
             alpaka::block::sync::syncBlockThreads(acc);
-            /* < CHECK & ADD >
-             * - if a thread wants to create electrons in each cycle it can do that only once
-             * and before that it atomically adds to the shared counter and uses the current
-             * value as electronId in the new frame
-             * - then sync
-             */
-            if (newMacroElectrons > 0)
-                electronId = alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &newFrameFillLvl, 1);
 
-            alpaka::block::sync::syncBlockThreads(acc);
-            /* < EXIT? >
-             * - if the counter hasn't changed all threads break out of the loop */
-            if (oldFrameFillLvl == newFrameFillLvl)
-                break;
+            /* < IONIZATION and change of charge states >
+             * if the threads contain particles, the frameIonizer can ionize them
+             * if they are non-particles their inner ionization counter remains at 0
+             */
+            if (isParticle)
+                /* ionization based on ionization model - this actually increases charge states*/
+                frameIonizer(*ionFrame, linearThreadIdx, newMacroElectrons);
 
             alpaka::block::sync::syncBlockThreads(acc);
-            /* < FIRST NEW FRAME >
-             * - if there is no frame, yet, the master will create a new target electron frame
-             * and attach it to the back of the frame list
-             * - sync all threads again for them to know which frame to use
+            /* always true while-loop over all particles inside source frame until each thread breaks out individually
+             *
+             * **Attention**: Speaking of 1st and 2nd frame only may seem odd.
+             * The question might arise what happens if more electrons are created than would fit into two frames.
+             * Well, multi-ionization during a time step is accounted for. The number of new electrons is
+             * determined inside the outer loop over the valid frames while in the inner loop each thread can create only ONE
+             * new macro electron. But the loop repeats until each thread has created all the electrons needed in the time step.
              */
-            if (linearThreadIdx == 0)
+            while (true)
             {
-                if (electronFrame == NULL)
+                /* < INIT >
+                 * - electronId is initialized as -1 (meaning: invalid)
+                 * - (local) oldFrameFillLvl set equal to (shared) newFrameFillLvl for each thread
+                 * --> each thread remembers the old "counter"
+                 * - then sync
+                 */
+                electronId = -1;
+                oldFrameFillLvl = newFrameFillLvl;
+                alpaka::block::sync::syncBlockThreads(acc);
+                /* < CHECK & ADD >
+                 * - if a thread wants to create electrons in each cycle it can do that only once
+                 * and before that it atomically adds to the shared counter and uses the current
+                 * value as electronId in the new frame
+                 * - then sync
+                 */
+                if (newMacroElectrons > 0)
+                    electronId = alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &newFrameFillLvl, 1);
+
+                alpaka::block::sync::syncBlockThreads(acc);
+                /* < EXIT? >
+                 * - if the counter hasn't changed all threads break out of the loop */
+                if (oldFrameFillLvl == newFrameFillLvl)
+                    break;
+
+                alpaka::block::sync::syncBlockThreads(acc);
+                /* < FIRST NEW FRAME >
+                 * - if there is no frame, yet, the master will create a new target electron frame
+                 * and attach it to the back of the frame list
+                 * - sync all threads again for them to know which frame to use
+                 */
+                if (linearThreadIdx == 0)
                 {
-                    electronFrame = &(electronBox.getEmptyFrame());
-                    electronBox.setAsLastFrame(acc, *electronFrame, block);
+                    if (electronFrame == NULL)
+                    {
+                        electronFrame = &(electronBox.getEmptyFrame(acc));
+                        electronBox.setAsLastFrame(acc, *electronFrame, block);
+                    }
                 }
-            }
-            alpaka::block::sync::syncBlockThreads(acc);
-            /* < CREATE 1 >
-             * - all electrons fitting into the current frame are created there
-             * - internal ionization counter is decremented by 1
-             * - sync
-             */
-            if ((0 <= electronId) && (electronId < maxParticlesInFrame))
-            {
-                /* each thread makes the attributes of its ion accessible */
-                PMACC_AUTO(parentIon,((*ionFrame)[linearThreadIdx]));
-                /* each thread initializes an electron if one should be created */
-                PMACC_AUTO(targetElectronFull,((*electronFrame)[electronId]));
-
-                /* create an electron in the new electron frame:
-                 * - see particles/ionization/ionizationMethods.hpp
+                alpaka::block::sync::syncBlockThreads(acc);
+                /* < CREATE 1 >
+                 * - all electrons fitting into the current frame are created there
+                 * - internal ionization counter is decremented by 1
+                 * - sync
                  */
-                WriteElectronIntoFrame writeElectron;
-                writeElectron(parentIon,targetElectronFull);
-
-                newMacroElectrons -= 1;
-            }
-            alpaka::block::sync::syncBlockThreads(acc);
-            /* < SECOND NEW FRAME >
-             * - if the shared counter is larger than the frame size a new electron frame is reserved
-             * and attached to the back of the frame list
-             * - then the shared counter is set back by one frame size
-             * - sync so that every thread knows about the new frame
-             */
-            if (linearThreadIdx == 0)
-            {
-                if (newFrameFillLvl >= maxParticlesInFrame)
+                if ((0 <= electronId) && (electronId < maxParticlesInFrame))
                 {
-                    electronFrame = &(electronBox.getEmptyFrame());
-                    electronBox.setAsLastFrame(acc, *electronFrame, block);
-                    newFrameFillLvl -= maxParticlesInFrame;
+                    /* each thread makes the attributes of its ion accessible */
+                    PMACC_AUTO(parentIon,((*ionFrame)[linearThreadIdx]));
+                    /* each thread initializes an electron if one should be created */
+                    PMACC_AUTO(targetElectronFull,((*electronFrame)[electronId]));
+
+                    /* create an electron in the new electron frame:
+                     * - see particles/ionization/ionizationMethods.hpp
+                     */
+                    WriteElectronIntoFrame writeElectron;
+                    writeElectron(parentIon,targetElectronFull);
+
+                    newMacroElectrons -= 1;
                 }
-            }
-            alpaka::block::sync::syncBlockThreads(acc);
-            /* < CREATE 2 >
-             * - if the EID is larger than the frame size
-             *      - the EID is set back by one frame size
-             *      - the thread writes an electron to the new frame
-             *      - the internal counter is decremented by 1
-             */
-            if (electronId >= maxParticlesInFrame)
-            {
-                electronId -= maxParticlesInFrame;
+                alpaka::block::sync::syncBlockThreads(acc);
+                /* < SECOND NEW FRAME >
+                 * - if the shared counter is larger than the frame size a new electron frame is reserved
+                 * and attached to the back of the frame list
+                 * - then the shared counter is set back by one frame size
+                 * - sync so that every thread knows about the new frame
+                 */
+                if (linearThreadIdx == 0)
+                {
+                    if (newFrameFillLvl >= maxParticlesInFrame)
+                    {
+                        electronFrame = &(electronBox.getEmptyFrame(acc));
+                        electronBox.setAsLastFrame(acc, *electronFrame, block);
+                        newFrameFillLvl -= maxParticlesInFrame;
+                    }
+                }
+                alpaka::block::sync::syncBlockThreads(acc);
+                /* < CREATE 2 >
+                 * - if the EID is larger than the frame size
+                 *      - the EID is set back by one frame size
+                 *      - the thread writes an electron to the new frame
+                 *      - the internal counter is decremented by 1
+                 */
+                if (electronId >= maxParticlesInFrame)
+                {
+                    electronId -= maxParticlesInFrame;
 
-                /* each thread makes the attributes of its ion accessible */
-                PMACC_AUTO(parentIon,((*ionFrame)[linearThreadIdx]));
-                /* each thread initializes an electron if one should be produced */
-                PMACC_AUTO(targetElectronFull,((*electronFrame)[electronId]));
+                    /* each thread makes the attributes of its ion accessible */
+                    PMACC_AUTO(parentIon,((*ionFrame)[linearThreadIdx]));
+                    /* each thread initializes an electron if one should be produced */
+                    PMACC_AUTO(targetElectronFull,((*electronFrame)[electronId]));
 
-                /* create an electron in the new electron frame:
-                 * - see particles/ionization/ionizationMethods.hpp
-                 */
-                WriteElectronIntoFrame writeElectron;
-                writeElectron(parentIon,targetElectronFull);
+                    /* create an electron in the new electron frame:
+                     * - see particles/ionization/ionizationMethods.hpp
+                     */
+                    WriteElectronIntoFrame writeElectron;
+                    writeElectron(parentIon,targetElectronFull);
 
-                newMacroElectrons -= 1;
+                    newMacroElectrons -= 1;
+                }
+                alpaka::block::sync::syncBlockThreads(acc);
             }
             alpaka::block::sync::syncBlockThreads(acc);
-        }
-        alpaka::block::sync::syncBlockThreads(acc);
 
-        if (linearThreadIdx == 0)
-        {
-            ionFrame = &(ionBox.getPreviousFrame(*ionFrame, isValid));
-            maxParticlesInFrame = PMacc::math::CT::volume<SuperCellSize>::type::value;
+            if (linearThreadIdx == 0)
+            {
+                ionFrame = &(ionBox.getPreviousFrame(*ionFrame, isValid));
+                maxParticlesInFrame = PMacc::math::CT::volume<SuperCellSize>::type::value;
+            }
+            alpaka::block::sync::syncBlockThreads(acc);
         }
-        alpaka::block::sync::syncBlockThreads(acc);
-    }
+    });
 }
 };
 
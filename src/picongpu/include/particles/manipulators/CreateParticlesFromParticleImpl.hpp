@@ -106,7 +106,7 @@ struct CreateParticlesFromParticleImpl : private T_Functor
                 }
                 if (!isValid || particlesInDestSuperCell == cellsInSuperCell)
                 {
-                    destFrame = &(destParBox.getEmptyFrame());
+                    destFrame = &(destParBox.getEmptyFrame(acc));
                     destParBox.setAsLastFrame(acc, *destFrame, superCell);
                 }
                 firstCall = false;
@@ -145,7 +145,7 @@ struct CreateParticlesFromParticleImpl : private T_Functor
                 if (particlesInDestSuperCell >= cellsInSuperCell)
                 {
                     particlesInDestSuperCell -= cellsInSuperCell;
-                    destFrame = &(destParBox.getEmptyFrame());
+                    destFrame = &(destParBox.getEmptyFrame(acc));
                     destParBox.setAsLastFrame(acc, *destFrame, superCell);
                 }
             }
@@ -26,6 +26,8 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <deque>
+#include <utility>
 
 #include "types.h"
 #include "simulation_defines.hpp"
@@ -33,14 +35,10 @@
 #include "dimensions/DataSpace.hpp"
 
 #include "simulation_classTypes.hpp"
-#include "mappings/kernel/AreaMapping.hpp"
 #include "plugins/ISimulationPlugin.hpp"
+#include "plugins/particleDiagnostics/ParticleDiagnostics.hpp"
 
-#include "mpi/reduceMethods/Reduce.hpp"
-#include "mpi/MPIReduce.hpp"
-#include "nvidia/functors/Add.hpp"
-
-#include "algorithms/Gamma.hpp"
+#include "mpi/ReduceFuture.hpp"
 
 #include "common/txtFileHandling.hpp"
 
@@ -50,206 +48,6 @@ using namespace PMacc;
 
 namespace po = boost::program_options;
 
-/* sum up the energy of all particles
- * the kinetic energy of all active particles will be calculated
- */
-struct KernelBinEnergyParticles
-{
-template<
-    typename T_Acc,
-    typename FRAME,
-    typename BinBox,
-    typename Mapping>
-ALPAKA_FN_ACC void operator()(
-    T_Acc const & acc,
-    ParticlesBox<FRAME, simDim> const & pb,
-    BinBox const & gBins,
-    int const & numBins,
-    float_X const & minEnergy,
-    float_X const & maxEnergy,
-    float_X const & maximumSlopeToDetectorX,
-    float_X const & maximumSlopeToDetectorZ,
-    Mapping const & mapper) const
-{
-    typedef typename MappingDesc::SuperCellSize Block;
-
-    DataSpace<simDim> const blockIndex(alpaka::idx::getIdx<alpaka::Grid, alpaka::Blocks>(acc));
-    DataSpace<simDim> const threadIndex(alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc));
-
-    auto frame(alpaka::block::shared::allocVar<FRAME *>(acc));
-    auto isValid(alpaka::block::shared::allocVar<bool>(acc));
-    auto particlesInSuperCell(alpaka::block::shared::allocVar<lcellId_t>(acc));
-
-    const bool enableDetector = maximumSlopeToDetectorX != float_X(0.0) && maximumSlopeToDetectorZ != float_X(0.0);
-
-    /* shBins index can go from 0 to (numBins+2)-1
-     * 0 is for <minEnergy
-     * (numBins+2)-1 is for >maxEnergy
-     */
-    float_X * const shBin(acc.template getBlockSharedExternMem<float_X>()); /* size must be numBins+2 because we have <min and >max */
-
-    alpaka::block::sync::syncBlockThreads(acc); /*wait that all shared memory is initialised*/
-
-    int realNumBins = numBins + 2;
-
-
-
-    typedef typename Mapping::SuperCellSize SuperCellSize;
-    const int threads = PMacc::math::CT::volume<SuperCellSize>::type::value;
-
-    const int linearThreadIdx = DataSpaceOperations<simDim>::template map<SuperCellSize > (threadIndex);
-
-    if (linearThreadIdx == 0)
-    {
-        const DataSpace<simDim> superCellIdx(mapper.getSuperCellIndex(DataSpace<simDim > (blockIndex)));
-        frame = &(pb.getLastFrame(superCellIdx, isValid));
-        particlesInSuperCell = pb.getSuperCell(superCellIdx).getSizeLastFrame();
-    }
-    /* set all bins to 0 */
-    for (int i = linearThreadIdx; i < realNumBins; i += threads)
-    {
-        shBin[i] = float_X(0.);
-    }
-
-    alpaka::block::sync::syncBlockThreads(acc);
-    if (!isValid)
-        return; /* end kernel if we have no frames */
-
-    while (isValid)
-    {
-        if (linearThreadIdx < particlesInSuperCell)
-        {
-            PMACC_AUTO(particle,(*frame)[linearThreadIdx]);
-            /* kinetic Energy for Particles: E^2 = p^2*c^2 + m^2*c^4
-             *                                   = c^2 * [p^2 + m^2*c^2] */
-            const float3_X mom = particle[momentum_];
-
-            bool calcParticle = true;
-
-            if (enableDetector && mom.y() > 0.0)
-            {
-                const float_X slopeMomX = abs(mom.x() / mom.y());
-                const float_X slopeMomZ = abs(mom.z() / mom.y());
-                if (slopeMomX >= maximumSlopeToDetectorX || slopeMomZ >= maximumSlopeToDetectorZ)
-                {
-                    calcParticle = false;
-                }
-            }
-
-            if (calcParticle)
-            {
-                /* \todo: this is a duplication of the code in EnergyParticles - in separate file? */
-                const float_X mom2 = math::abs2(mom);
-                const float_X weighting = particle[weighting_];
-                const float_X mass = attribute::getMass(weighting,particle);
-                const float_X c2 = SPEED_OF_LIGHT * SPEED_OF_LIGHT;
-
-                Gamma<> calcGamma;
-                const float_X gamma = calcGamma(mom, mass);
-
-                float_X _local_energy;
-
-                if (gamma < GAMMA_THRESH)
-                {
-                    _local_energy = mom2 / (2.0f * mass); /* not relativistic use equation with more precision */
-                }
-                else
-                {
-                    /* kinetic Energy for Particles: E = (sqrt[p^2*c^2 /(m^2*c^4)+ 1] -1) m*c^2
-                     *                                   = c^2 * [p^2 + m^2*c^2]-m*c^2
-                     *                                 = (gamma - 1) * m * c^2   */
-                    _local_energy = (gamma - float_X(1.0)) * mass*c2;
-                }
-                _local_energy /= weighting;
-
-                /* +1 move value from 1 to numBins+1 */
-                int binNumber = math::floor((_local_energy - minEnergy) /
-                                      (maxEnergy - minEnergy) * (float) numBins) + 1;
-
-                const int maxBin = numBins + 1;
-
-                /* all entries larger than maxEnergy go into bin maxBin */
-                binNumber = binNumber < maxBin ? binNumber : maxBin;
-
-                /* all entries smaller than minEnergy go into bin zero */
-                binNumber = binNumber > 0 ? binNumber : 0;
-
-                /*!\todo: we can't use 64bit type on this place (NVIDIA BUG?)
-                 * COMPILER ERROR: ptxas /tmp/tmpxft_00005da6_00000000-2_main.ptx, line 4246; error   : Global state space expected for instruction 'atom'
-                 * I think this is a problem with extern shared mem and atmic (only on TESLA)
-                 * NEXT BUG: don't do uint32_t w=__float2uint_rn(weighting); and use w for atomic, this create wrong results
-                 */
-                /* overflow for big weighting reduces in shared mem */
-                /* atomicAdd(&(shBin[binNumber]), (uint32_t) weighting); */
-                const float_X normedWeighting = float_X(weighting) / float_X(particles::TYPICAL_NUM_PARTICLES_PER_MACROPARTICLE);
-                alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(shBin[binNumber]), normedWeighting);
-            }
-        }
-        alpaka::block::sync::syncBlockThreads(acc);
-        if (linearThreadIdx == 0)
-        {
-            frame = &(pb.getPreviousFrame(*frame, isValid));
-            particlesInSuperCell = PMacc::math::CT::volume<Block>::type::value;
-        }
-        alpaka::block::sync::syncBlockThreads(acc);
-    }
-
-    alpaka::block::sync::syncBlockThreads(acc);
-    for (int i = linearThreadIdx; i < realNumBins; i += threads)
-    {
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(gBins[i]), float_64(shBin[i]));
-    }
-    alpaka::block::sync::syncBlockThreads(acc);
-}
-};
-
-}
-
-namespace alpaka
-{
-    namespace kernel
-    {
-        namespace traits
-        {
-            //#############################################################################
-            //! The trait for getting the size of the block shared extern memory for a kernel.
-            //#############################################################################
-            template<
-                typename T_Acc>
-            struct BlockSharedExternMemSizeBytes<
-                picongpu::KernelBinEnergyParticles,
-                T_Acc>
-            {
-                //-----------------------------------------------------------------------------
-                //! \return The size of the shared memory allocated for a block.
-                //-----------------------------------------------------------------------------
-                template<
-                    typename TDim,
-                    typename FRAME,
-                    typename BinBox,
-                    typename Mapping>
-                ALPAKA_FN_HOST static auto getBlockSharedExternMemSizeBytes(
-                    alpaka::Vec<TDim, alpaka::size::Size<T_Acc>> const & vuiBlockThreadsExtents,
-                    picongpu::ParticlesBox<FRAME, picongpu::simDim> const & pb,
-                    BinBox const & gBins,
-                    int const & numBins,
-                    picongpu::float_X const & minEnergy,
-                    picongpu::float_X const & maxEnergy,
-                    picongpu::float_X const & maximumSlopeToDetectorX,
-                    picongpu::float_X const & maximumSlopeToDetectorZ,
-                    Mapping const & mapper)
-                -> alpaka::size::Size<T_Acc>
-                {
-                    return (numBins + 2) * sizeof(picongpu::float_X);
-                }
-            };
-        }
-    }
-}
-
-namespace picongpu
-{
-
 template<class ParticlesType>
 class BinEnergyParticles : public ISimulationPlugin
 {
@@ -257,17 +55,12 @@ private:
 
     typedef MappingDesc::SuperCellSize SuperCellSize;
 
-    ParticlesType *particles;
-
-    GridBuffer<double, DIM1> *gBins;
     MappingDesc *cellDescription;
 
     std::string analyzerName;
     std::string analyzerPrefix;
     std::string filename;
 
-    double * binReduced;
-
     uint32_t notifyPeriod;
     int numBins;
     int realNumBins;
@@ -285,7 +78,8 @@ private:
     /* only rank 0 create a file */
     bool writeToFile;
 
-    mpi::MPIReduce reduce;
+    /* started reduces of the histogram over all GPUs, written in order of the time steps */
+    std::deque<std::pair<uint32_t, mpi::ReduceFuture<float_64> > > pendingHistograms;
 
 public:
 
@@ -293,8 +87,6 @@ public:
     analyzerName("BinEnergyParticles: calculate a energy histogram of a species"),
     analyzerPrefix(ParticlesType::FrameType::getName() + std::string("_energyHistogram")),
     filename(analyzerPrefix + ".dat"),
-    particles(NULL),
-    gBins(NULL),
     cellDescription(NULL),
     notifyPeriod(0),
     writeToFile(false),
@@ -307,10 +99,7 @@ public:
 
     void notify(uint32_t currentStep)
     {
-        DataConnector &dc = Environment<>::get().DataConnector();
-        particles = &(dc.getData<ParticlesType > (ParticlesType::FrameType::getName(), true));
-
-        calBinEnergyParticles < CORE + BORDER > (currentStep);
+        calBinEnergyParticles(currentStep);
     }
 
     void pluginRegisterHelp(po::options_description& desc)
@@ -384,15 +173,28 @@ private:
 
             realNumBins = numBins + 2;
 
-            /* create an array of double on gpu und host */
-            gBins = new GridBuffer<double, DIM1 > (DataSpace<DIM1 > (realNumBins));
-            binReduced = new double[realNumBins];
-            for (int i = 0; i < realNumBins; ++i)
+            /** Assumption: distanceToDetector >> simulated Area in y-Direction
+             *          AND     simulated area in X,Z << slit  */
+            float_X maximumSlopeToDetectorX = 0.0; /*0.0 is disabled detector*/
+            float_X maximumSlopeToDetectorZ = 0.0; /*0.0 is disabled detector*/
+            if (enableDetector)
             {
-                binReduced[i] = 0.0;
+                maximumSlopeToDetectorX = (slitDetectorX / 2.0) / (distanceToDetector);
+                maximumSlopeToDetectorZ = (slitDetectorZ / 2.0) / (distanceToDetector);
+                /* maximumSlopeToDetector = (radiusDetector * radiusDetector) / (distanceToDetector * distanceToDetector); */
             }
 
-            writeToFile = reduce.hasResult(mpi::reduceMethods::Reduce());
+            /* convert energy values from keV to PIConGPU units */
+            const float_X minEnergy = minEnergy_keV * UNITCONV_keV_to_Joule / UNIT_ENERGY;
+            const float_X maxEnergy = maxEnergy_keV * UNITCONV_keV_to_Joule / UNIT_ENERGY;
+
+            /* the histogram is filled in the particle sweep of all diagnostics of the species */
+            ParticleDiagnostics<ParticlesType>& diagnostics = ParticleDiagnostics<ParticlesType>::getInstance();
+            diagnostics.setEnergyHistogram(numBins, minEnergy, maxEnergy,
+                                           maximumSlopeToDetectorX, maximumSlopeToDetectorZ);
+            diagnostics.enable(particleDiagnostics::ENERGY_HISTOGRAM, notifyPeriod);
+
+            writeToFile = diagnostics.hasReducedResult();
             if( writeToFile )
                 openNewFile();
 
@@ -406,6 +208,7 @@ private:
         {
             if (writeToFile)
             {
+                writeFinishedHistograms(true);
                 outFile.flush();
                 outFile << std::endl; /* now all data are written to file */
                 if (outFile.fail())
@@ -413,8 +216,7 @@ private:
                 outFile.close();
             }
 
-            __delete(gBins);
-            __deleteArray(binReduced);
+            ParticleDiagnostics<ParticlesType>::getInstance().disable(particleDiagnostics::ENERGY_HISTOGRAM);
         }
     }
 
@@ -434,61 +236,44 @@ private:
         if( !writeToFile )
             return;
 
+        writeFinishedHistograms(true);
         checkpointTxtFile( outFile,
                            filename,
                            currentStep,
                            checkpointDirectory );
     }
 
-    template< uint32_t AREA>
     void calBinEnergyParticles(uint32_t currentStep)
     {
-        gBins->getDeviceBuffer().setValue(0);
-        DataSpace<simDim> block(MappingDesc::SuperCellSize::toRT());
-
-        /** Assumption: distanceToDetector >> simulated Area in y-Direction
-         *          AND     simulated area in X,Z << slit  */
-        double maximumSlopeToDetectorX = 0.0; /*0.0 is disabled detector*/
-        double maximumSlopeToDetectorZ = 0.0; /*0.0 is disabled detector*/
-        if (enableDetector)
-        {
-            maximumSlopeToDetectorX = (slitDetectorX / 2.0) / (distanceToDetector);
-            maximumSlopeToDetectorZ = (slitDetectorZ / 2.0) / (distanceToDetector);
-            /* maximumSlopeToDetector = (radiusDetector * radiusDetector) / (distanceToDetector * distanceToDetector); */
-        }
-
-        /* convert energy values from keV to PIConGPU units */
-        const float_X minEnergy = minEnergy_keV * UNITCONV_keV_to_Joule / UNIT_ENERGY;
-        const float_X maxEnergy = maxEnergy_keV * UNITCONV_keV_to_Joule / UNIT_ENERGY;
-
-        KernelBinEnergyParticles kernelBinEnergyParticles;
-        __picKernelArea(
-            kernelBinEnergyParticles,
-            alpaka::dim::DimInt<simDim>,
-            *cellDescription,
-            AREA,
-            block)
-            (particles->getDeviceParticlesBox(),
-             gBins->getDeviceBuffer().getDataBox(), numBins, minEnergy,
-             maxEnergy, maximumSlopeToDetectorX, maximumSlopeToDetectorZ);
+        /* the sum of the histogram over all GPUs is not blocking */
+        mpi::ReduceFuture<float_64> reducedSums =
+            ParticleDiagnostics<ParticlesType>::getInstance().getReducedSums(currentStep, particleDiagnostics::ENERGY_HISTOGRAM);
 
-        gBins->deviceToHost();
-
-        reduce(nvidia::functors::Add(),
-               binReduced,
-               gBins->getHostBuffer().getBasePointer(),
-               realNumBins, mpi::reduceMethods::Reduce());
+        if (writeToFile)
+            pendingHistograms.push_back(std::make_pair(currentStep, reducedSums));
 
+        writeFinishedHistograms(false);
+    }
 
-        if (writeToFile)
+    /** write the histograms of all finished reduces to file
+     *
+     * @param waitForAll block until all started reduces are finished
+     */
+    void writeFinishedHistograms(const bool waitForAll)
+    {
+        while (!pendingHistograms.empty() && (waitForAll || pendingHistograms.front().second.isFinished()))
         {
+            const uint32_t step = pendingHistograms.front().first;
+            const float_64* binReduced =
+                pendingHistograms.front().second.get() + particleDiagnostics::HISTOGRAM_IDX;
+
             typedef std::numeric_limits< float_64 > dbl;
 
             outFile.precision(dbl::digits10);
 
             /* write data to file */
             double count_particles = 0.0;
-            outFile << currentStep << " "
+            outFile << step << " "
                     << std::scientific; /*  for floating points, ignored for ints */
 
             for (int i = 0; i < realNumBins; ++i)
@@ -500,6 +285,8 @@ private:
                 << std::endl;
             /* endl: Flush any step to the file.
              * Thus, we will have data if the program should crash. */
+
+            pendingHistograms.pop_front();
         }
     }
 
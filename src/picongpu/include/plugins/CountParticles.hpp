@@ -25,24 +25,21 @@
 #include "simulation_types.hpp"
 
 #include "simulation_classTypes.hpp"
-#include "mappings/kernel/AreaMapping.hpp"
 
 #include <string>
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <deque>
 
 #include "plugins/ISimulationPlugin.hpp"
+#include "plugins/particleDiagnostics/ParticleDiagnostics.hpp"
 
 #include "mpi/reduceMethods/Reduce.hpp"
 #include "mpi/MPIReduce.hpp"
-#include "nvidia/functors/Add.hpp"
+#include "mpi/ReduceFuture.hpp"
 #include "nvidia/functors/Max.hpp"
 
-#include "simulation_classTypes.hpp"
-
-#include "particles/operations/CountParticles.hpp"
-
 #include "common/txtFileHandling.hpp"
 
 namespace picongpu
@@ -55,8 +52,6 @@ class CountParticles : public ISimulationPlugin
 private:
     typedef MappingDesc::SuperCellSize SuperCellSize;
 
-    ParticlesType *particles;
-
     MappingDesc *cellDescription;
     uint32_t notifyPeriod;
 
@@ -69,13 +64,25 @@ private:
     bool writeToFile;
 
     mpi::MPIReduce reduce;
+
+    /* started reduces of one time step */
+    struct PendingCount
+    {
+        uint32_t step;
+        /* \see particleDiagnostics::SumIdx */
+        mpi::ReduceFuture<float_64> sums;
+        /* only valid if the log level CRITICAL is enabled */
+        mpi::ReduceFuture<uint64_cu> maximum;
+    };
+
+    /* written in order of the time steps */
+    std::deque<PendingCount> pendingCounts;
 public:
 
     CountParticles() :
     analyzerName("CountParticles: count macro particles of a species"),
     analyzerPrefix(ParticlesType::FrameType::getName() + std::string("_macroParticlesCount")),
     filename(analyzerPrefix + ".dat"),
-    particles(NULL),
     cellDescription(NULL),
     notifyPeriod(0),
     writeToFile(false)
@@ -87,11 +94,7 @@ public:
 
     void notify(uint32_t currentStep)
     {
-        DataConnector &dc = Environment<>::get().DataConnector();
-
-        particles = &(dc.getData<ParticlesType > (ParticlesType::FrameType::getName(), true));
-
-        countParticles < CORE + BORDER > (currentStep);
+        countParticles(currentStep);
     }
 
     void pluginRegisterHelp(po::options_description& desc)
@@ -117,7 +120,10 @@ private:
     {
         if (notifyPeriod > 0)
         {
-            writeToFile = reduce.hasResult(mpi::reduceMethods::Reduce());
+            ParticleDiagnostics<ParticlesType>& diagnostics = ParticleDiagnostics<ParticlesType>::getInstance();
+            diagnostics.enable(particleDiagnostics::COUNT, notifyPeriod);
+
+            writeToFile = diagnostics.hasReducedResult();
 
             if (writeToFile)
             {
@@ -141,12 +147,15 @@ private:
         {
             if (writeToFile)
             {
+                writeFinishedCounts(true);
                 outFile.flush();
                 outFile << std::endl; //now all data are written to file
                 if (outFile.fail())
                     std::cerr << "Error on flushing file [" << filename << "]. " << std::endl;
                 outFile.close();
             }
+
+            ParticleDiagnostics<ParticlesType>::getInstance().disable(particleDiagnostics::COUNT);
         }
     }
 
@@ -166,51 +175,62 @@ private:
         if( !writeToFile )
             return;
 
+        writeFinishedCounts(true);
         checkpointTxtFile( outFile,
                            filename,
                            currentStep,
                            checkpointDirectory );
     }
 
-    template< uint32_t AREA>
     void countParticles(uint32_t currentStep)
     {
-        uint64_cu size;
+        ParticleDiagnostics<ParticlesType>& diagnostics = ParticleDiagnostics<ParticlesType>::getInstance();
 
-        const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
-        const DataSpace<simDim> localSize(subGrid.getLocalDomain().size);
+        /* local particles are counted in the particle sweep of all diagnostics of the species */
+        uint64_cu size = diagnostics.getLocalCount(currentStep);
 
-        /*count local particles*/
-        size = PMacc::CountParticles::countOnDevice<AREA>(*particles,
-                                                          *cellDescription,
-                                                          DataSpace<simDim>(),
-                                                          localSize);
-        uint64_cu reducedValueMax;
+        PendingCount pending;
+        pending.step = currentStep;
         if (picLog::log_level & picLog::CRITICAL::lvl)
         {
-            reduce(nvidia::functors::Max(),
-                   &reducedValueMax,
-                   &size,
-                   1,
-                   mpi::reduceMethods::Reduce());
+            pending.maximum = reduce.startReduce(nvidia::functors::Max(),
+                                                 &size,
+                                                 1,
+                                                 mpi::reduceMethods::Reduce());
         }
 
-
-        uint64_cu reducedValue;
-        reduce(nvidia::functors::Add(),
-               &reducedValue,
-               &size,
-               1,
-               mpi::reduceMethods::Reduce());
+        /* the sum is part of the non-blocking reduce of all diagnostics of the species */
+        pending.sums = diagnostics.getReducedSums(currentStep, particleDiagnostics::COUNT);
 
         if (writeToFile)
+            pendingCounts.push_back(pending);
+
+        writeFinishedCounts(false);
+    }
+
+    /** write the counts of all finished reduces to file
+     *
+     * @param waitForAll block until all started reduces are finished
+     */
+    void writeFinishedCounts(const bool waitForAll)
+    {
+        while (!pendingCounts.empty())
         {
-            if (picLog::log_level & picLog::CRITICAL::lvl)
+            PendingCount& pending = pendingCounts.front();
+            const bool isFinished = pending.sums.isFinished() &&
+                (!pending.maximum.isValid() || pending.maximum.isFinished());
+            if (!waitForAll && !isFinished)
+                break;
+
+            if (pending.maximum.isValid())
             {
-                log<picLog::CRITICAL > ("maximum number of  particles on a GPU : %d\n") % reducedValueMax;
+                log<picLog::CRITICAL > ("maximum number of  particles on a GPU : %d\n") % pending.maximum.get()[0];
             }
 
-            outFile << currentStep << " " << reducedValue << " " << std::scientific << (double) reducedValue << std::endl;
+            const uint64_cu reducedValue = uint64_cu(pending.sums.get()[particleDiagnostics::COUNT_IDX]);
+            outFile << pending.step << " " << reducedValue << " " << std::scientific << (double) reducedValue << std::endl;
+
+            pendingCounts.pop_front();
         }
     }
 
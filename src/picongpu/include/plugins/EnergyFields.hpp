@@ -24,6 +24,8 @@
 
 #include <iostream>
 #include <fstream>
+#include <deque>
+#include <utility>
 
 #include "types.h"
 #include "simulation_defines.hpp"
@@ -39,6 +41,7 @@
 
 #include "mpi/reduceMethods/Reduce.hpp"
 #include "mpi/MPIReduce.hpp"
+#include "mpi/ReduceFuture.hpp"
 #include "nvidia/functors/Add.hpp"
 #include "nvidia/reduce/Reduce.hpp"
 #include "memory/boxes/DataBoxDim1Access.hpp"
@@ -77,6 +80,40 @@ struct squareComponentWise
     }
 };
 
+/** squared components of B and E of a cell
+ *
+ * The energy of both fields is reduced in one pass over the cells,
+ * components [0, numComponents) are B, the remaining are E.
+ */
+template<typename T_BoxB, typename T_BoxE>
+struct FieldEnergyBox
+{
+    static const uint32_t numComponents = T_BoxB::ValueType::dim;
+    typedef PMacc::math::Vector<float_64, 2 * numComponents> ValueType;
+    typedef ValueType RefValueType;
+
+    HDINLINE FieldEnergyBox(const T_BoxB& boxB, const T_BoxE& boxE) : boxB(boxB), boxE(boxE)
+    {
+    }
+
+    HDINLINE ValueType operator[](const int idx) const
+    {
+        const typename T_BoxB::ValueType b = boxB[idx];
+        const typename T_BoxE::ValueType e = boxE[idx];
+        ValueType result;
+        for (uint32_t d = 0; d < numComponents; ++d)
+        {
+            result[d] = b[d];
+            result[numComponents + d] = e[d];
+        }
+        return result;
+    }
+
+private:
+    PMACC_ALIGN(boxB, T_BoxB);
+    PMACC_ALIGN(boxE, T_BoxE);
+};
+
 }
 
 class EnergyFields : public ISimulationPlugin
@@ -101,6 +138,9 @@ private:
 
     typedef promoteType<float_64, FieldB::ValueType>::type EneVectorType;
 
+    /* started reduces of the energies over all GPUs, written in order of the time steps */
+    std::deque<std::pair<uint32_t, mpi::ReduceFuture<EneVectorType> > > pendingEnergies;
+
 public:
 
     EnergyFields() :
@@ -175,6 +215,7 @@ private:
         {
             if (writeToFile)
             {
+                writeFinishedEnergies(true);
                 outFile.flush();
                 outFile << std::endl; //now all data are written to file
                 if (outFile.fail())
@@ -201,6 +242,7 @@ private:
         if( !writeToFile )
             return;
 
+        writeFinishedEnergies(true);
         checkpointTxtFile( outFile,
                            filename,
                            currentStep,
@@ -212,44 +254,58 @@ private:
         /* idx == 0 -> fieldB
          * idx == 1 -> fieldE
          */
-        EneVectorType globalFieldEnergy[2];
-        globalFieldEnergy[0]=EneVectorType::create(0.0);
-        globalFieldEnergy[1]=EneVectorType::create(0.0);
-
         EneVectorType localReducedFieldEnergy[2];
-        localReducedFieldEnergy[0] = reduceField(fieldB);
-        localReducedFieldEnergy[1] = reduceField(fieldE);
+        reduceFields(localReducedFieldEnergy);
 
-        mpiReduce(nvidia::functors::Add(),
-                  &globalFieldEnergy,
-                  &localReducedFieldEnergy,
-                  2,
-                  mpi::reduceMethods::Reduce());
+        /* the sum over all GPUs is not blocking */
+        mpi::ReduceFuture<EneVectorType> globalFieldEnergy =
+            mpiReduce.startReduce(nvidia::functors::Add(),
+                                  localReducedFieldEnergy,
+                                  2,
+                                  mpi::reduceMethods::Reduce());
 
-        float_64 energyFieldBReduced=0.0;
-        float_64 energyFieldEReduced=0.0;
+        if (writeToFile)
+            pendingEnergies.push_back(std::make_pair(currentStep, globalFieldEnergy));
+
+        writeFinishedEnergies(false);
+    }
 
-        for(int d=0; d<FieldB::numComponents; ++d)
+    /** write the energies of all finished reduces to file
+     *
+     * @param waitForAll block until all started reduces are finished
+     */
+    void writeFinishedEnergies(const bool waitForAll)
+    {
+        while (!pendingEnergies.empty() && (waitForAll || pendingEnergies.front().second.isFinished()))
         {
-            /* B field convert */
-            globalFieldEnergy[0][d] *= float_64(0.5 / MUE0 * CELL_VOLUME);
-            /* E field convert */
-            globalFieldEnergy[1][d] *= float_64(EPS0 * CELL_VOLUME * 0.5);
-
-            /* add all to one */
-            energyFieldBReduced+= globalFieldEnergy[0][d];
-            energyFieldEReduced+= globalFieldEnergy[1][d];
-        }
+            const uint32_t step = pendingEnergies.front().first;
+            const EneVectorType* reducedFieldEnergy = pendingEnergies.front().second.get();
+            EneVectorType globalFieldEnergy[2];
+            globalFieldEnergy[0] = reducedFieldEnergy[0];
+            globalFieldEnergy[1] = reducedFieldEnergy[1];
+            pendingEnergies.pop_front();
 
-        float_64 globalEnergy = energyFieldEReduced + energyFieldBReduced;
+            float_64 energyFieldBReduced=0.0;
+            float_64 energyFieldEReduced=0.0;
 
+            for(int d=0; d<FieldB::numComponents; ++d)
+            {
+                /* B field convert */
+                globalFieldEnergy[0][d] *= float_64(0.5 / MUE0 * CELL_VOLUME);
+                /* E field convert */
+                globalFieldEnergy[1][d] *= float_64(EPS0 * CELL_VOLUME * 0.5);
+
+                /* add all to one */
+                energyFieldBReduced+= globalFieldEnergy[0][d];
+                energyFieldEReduced+= globalFieldEnergy[1][d];
+            }
+
+            float_64 globalEnergy = energyFieldEReduced + energyFieldBReduced;
 
-        if (writeToFile)
-        {
             typedef std::numeric_limits< float_64 > dbl;
 
             outFile.precision(dbl::digits10);
-            outFile << currentStep << " " << std::scientific << globalEnergy * UNIT_ENERGY << " "
+            outFile << step << " " << std::scientific << globalEnergy * UNIT_ENERGY << " "
                     << (globalFieldEnergy[0] * UNIT_ENERGY).toString(" ","") << " "
                     << (globalFieldEnergy[1] * UNIT_ENERGY).toString(" ","") << std::endl;
         }
@@ -258,26 +314,47 @@ private:
 private:
 
     template<typename T_Field>
-    EneVectorType reduceField(T_Field* field)
+    struct D1Field
     {
         /*define stacked DataBox's for reduce algorithm*/
         typedef DataBoxUnaryTransform<typename T_Field::DataBoxType, energyFields::squareComponentWise > TransformedBox;
         typedef DataBoxUnaryTransform<TransformedBox, energyFields::cast64Bit > Box64bit;
-        typedef DataBoxDim1Access<Box64bit > D1Box;
+        typedef DataBoxDim1Access<Box64bit > type;
+
+        static type get(T_Field* field)
+        {
+            DataSpace<simDim> fieldSize = field->getGridLayout().getDataSpaceWithoutGuarding();
+            DataSpace<simDim> fieldGuard = field->getGridLayout().getGuard();
+
+            TransformedBox fieldTransform(field->getDeviceDataBox().shift(fieldGuard));
+            Box64bit field64bit(fieldTransform);
+            return type(field64bit, fieldSize);
+        }
+    };
 
-        /* reduce field E*/
-        DataSpace<simDim> fieldSize = field->getGridLayout().getDataSpaceWithoutGuarding();
-        DataSpace<simDim> fieldGuard = field->getGridLayout().getGuard();
+    /** reduce the squared components of B and E in one pass over the cells
+     *
+     * @param fieldEnergy [out] fieldEnergy[0] is B, fieldEnergy[1] is E
+     */
+    void reduceFields(EneVectorType* fieldEnergy)
+    {
+        typedef energyFields::FieldEnergyBox<
+            typename D1Field<FieldB>::type,
+            typename D1Field<FieldE>::type> EnergyBox;
 
-        TransformedBox fieldTransform(field->getDeviceDataBox().shift(fieldGuard));
-        Box64bit field64bit(fieldTransform);
-        D1Box d1Access(field64bit, fieldSize);
+        EnergyBox energyBox(D1Field<FieldB>::get(fieldB), D1Field<FieldE>::get(fieldE));
+        const DataSpace<simDim> fieldSize = fieldB->getGridLayout().getDataSpaceWithoutGuarding();
 
-        EneVectorType fieldEnergyReduced = (*localReduce)(nvidia::functors::Add(),
-                                               d1Access,
-                                               fieldSize.productOfComponents());
+        const typename EnergyBox::ValueType fieldEnergyReduced =
+            (*localReduce)(nvidia::functors::Add(),
+                           energyBox,
+                           fieldSize.productOfComponents());
 
-        return fieldEnergyReduced;
+        for (uint32_t d = 0; d < EnergyBox::numComponents; ++d)
+        {
+            fieldEnergy[0][d] = fieldEnergyReduced[d];
+            fieldEnergy[1][d] = fieldEnergyReduced[EnergyBox::numComponents + d];
+        }
     }
 
 };
@@ -25,6 +25,8 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <deque>
+#include <utility>
 #include <mpi.h>
 
 #include "types.h"
@@ -32,14 +34,10 @@
 #include "simulation_types.hpp"
 
 #include "simulation_classTypes.hpp"
-#include "mappings/kernel/AreaMapping.hpp"
 #include "plugins/ISimulationPlugin.hpp"
+#include "plugins/particleDiagnostics/ParticleDiagnostics.hpp"
 
-#include "mpi/reduceMethods/Reduce.hpp"
-#include "mpi/MPIReduce.hpp"
-#include "nvidia/functors/Add.hpp"
-
-#include "algorithms/Gamma.hpp"
+#include "mpi/ReduceFuture.hpp"
 
 #include "common/txtFileHandling.hpp"
 
@@ -49,131 +47,12 @@ using namespace PMacc;
 
 namespace po = boost::program_options;
 
-/** This kernel computes the kinetic and total energy summed over
- *  all particles of a species.
- **/
-struct KernelEnergyParticles
-{
-template<
-    typename T_Acc,
-    typename FRAME,
-    typename DBox,
-    typename Mapping>
-ALPAKA_FN_ACC void operator()(
-    T_Acc const & acc,
-    ParticlesBox<FRAME, simDim> const & pb,
-    DBox const & gEnergy,
-    Mapping const & mapper) const
-{
-    DataSpace<simDim> const blockIndex(alpaka::idx::getIdx<alpaka::Grid, alpaka::Blocks>(acc));
-    DataSpace<simDim> const threadIndex(alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc));
-
-    auto frame(alpaka::block::shared::allocVar<FRAME *>(acc));         /* pointer to particle data frame */
-    auto isValid(alpaka::block::shared::allocVar<bool>(acc));          /* is data frame valid? */
-    auto shEnergyKin(alpaka::block::shared::allocVar<float_X>(acc));   /* shared kinetic energy */
-    auto shEnergy(alpaka::block::shared::allocVar<float_X>(acc));      /* shared total energy */
-
-    alpaka::block::sync::syncBlockThreads(acc); /* wait that all shared memory is initialised */
-
-    float_X _local_energyKin = float_X(0.0); /* sum kinetic energy for this thread */
-    float_X _local_energy = float_X(0.0); /* sum total energy for this thread */
-
-
-    typedef typename Mapping::SuperCellSize SuperCellSize;
-
-    const int linearThreadIdx = DataSpaceOperations<simDim>::template map<SuperCellSize > (threadIndex);
-
-    if (linearThreadIdx == 0) /* only thread 0 runs initial set up */
-    {
-        const DataSpace<simDim> superCellIdx(mapper.getSuperCellIndex(DataSpace<simDim > (blockIndex)));
-        frame = &(pb.getLastFrame(superCellIdx, isValid)); /* get first(=last) frame */
-        shEnergyKin = float_X(0.0); /* set shared kinetic energy to zero */
-        shEnergy = float_X(0.0); /* set shared total energy to zero */
-    }
-
-    alpaka::block::sync::syncBlockThreads(acc); /* wait till thread 0 finishes set up */
-    if (!isValid)
-        return; /* end kernel if we have no frames */
-
-    /* this checks if the data loaded by a thread is filled with a particle
-     * or not. Only applies to the first loaded frame (=last frame) */
-    /* BUGFIX to issue #538
-     * volatile prohibits that the compiler creates wrong code*/
-    volatile bool isParticle = (*frame)[linearThreadIdx][multiMask_];
-
-    while (isValid)
-    {
-        if (isParticle)
-        {
-
-            PMACC_AUTO(particle,(*frame)[linearThreadIdx]); /* get one particle */
-            const float3_X mom = particle[momentum_]; /* get particle momentum */
-            /* and compute square of absolute momentum of one particle: */
-            const float_X mom2 = mom.x() * mom.x() + mom.y() * mom.y() + mom.z() * mom.z();
-
-            const float_X weighting = particle[weighting_]; /* get macro particle weighting */
-            const float_X mass = attribute::getMass(weighting,particle); /* compute mass using weighting */
-            const float_X c2 = SPEED_OF_LIGHT * SPEED_OF_LIGHT;
-
-            Gamma<> calcGamma; /* functor for computing relativistic gamma factor */
-            const float_X gamma = calcGamma(mom, mass); /* compute relativistic gamma */
-
-            if (gamma < GAMMA_THRESH) /* if particle energy is low enough: */
-            {
-                /* not relativistic: use equation with more precision */
-                _local_energyKin += mom2 / (2.0f * mass);
-            }
-            else /* if particle is relativistic */
-            {
-                /* kinetic energy for particles: E = (gamma - 1) * m * c^2
-                 *                                    gamma = sqrt( 1 + (p/m/c)^2 )
-                 * _local_energyKin += (sqrtf(mom2 / (mass * mass * c2) + 1.) - 1.) * mass * c2;
-                 */
-                _local_energyKin += (gamma - float_X(1.0)) * mass*c2;
-            }
-
-            /* total energy for particles: E^2 = p^2*c^2 + m^2*c^4
-             *                                   = c^2 * [p^2 + m^2*c^2]
-             */
-            _local_energy += sqrtf(mom2 + mass * mass * c2) * SPEED_OF_LIGHT;
-
-        }
-        alpaka::block::sync::syncBlockThreads(acc); /* wait till all threads have added their particle energies */
-
-        /* get next particle frame */
-        if (linearThreadIdx == 0)
-        {
-            /* set frame to next particle frame */
-            frame = &(pb.getPreviousFrame(*frame, isValid));
-        }
-        isParticle = true; /* all following frames are filled with particles */
-        alpaka::block::sync::syncBlockThreads(acc); /* wait till thread 0 is done */
-    }
-
-    /* add energies on block level using shared memory */
-    alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &shEnergyKin, _local_energyKin); /* add kinetic energy */
-    alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &shEnergy, _local_energy);       /* add total energy */
-
-    alpaka::block::sync::syncBlockThreads(acc); /* wait till all threads have added their energies */
-
-    /* add energies on global level using global memory */
-    if (linearThreadIdx == 0) /* only done by thread 0 of a block */
-    {
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(gEnergy[0]), (float_64) (shEnergyKin)); /* add kinetic energy */
-        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(gEnergy[1]), (float_64) (shEnergy));    /* add total energy */
-    }
-}
-};
-
 template<class ParticlesType>
 class EnergyParticles : public ISimulationPlugin
 {
 private:
     typedef MappingDesc::SuperCellSize SuperCellSize;
 
-    ParticlesType *particles; /* pointer to particle data */
-
-    GridBuffer<double, DIM1> *gEnergy; /* energy values (global on GPU) */
     MappingDesc *cellDescription;
     uint32_t notifyFrequency; /* periodocity of computing the particle energy */
 
@@ -184,7 +63,8 @@ private:
     std::ofstream outFile; /* file output stream */
     bool writeToFile;   /* only rank 0 creates a file */
 
-    mpi::MPIReduce reduce; /* MPI reduce to add all energies over several GPUs */
+    /* started reduces of the energies over all GPUs, written in order of the time steps */
+    std::deque<std::pair<uint32_t, mpi::ReduceFuture<float_64> > > pendingEnergies;
 
 public:
 
@@ -192,8 +72,6 @@ public:
     analyzerName("EnergyParticles: calculate the energy of a species"),
     analyzerPrefix(ParticlesType::FrameType::getName() + std::string("_energy")),
     filename(analyzerPrefix + ".dat"),
-    particles(NULL),
-    gEnergy(NULL),
     cellDescription(NULL),
     notifyFrequency(0),
     writeToFile(false)
@@ -208,13 +86,8 @@ public:
    * the energy **/
     void notify(uint32_t currentStep)
     {
-        DataConnector &dc = Environment<>::get().DataConnector(); /* get data connector */
-
-        /* use data connector to get particle data */
-        particles = &(dc.getData<ParticlesType > (ParticlesType::FrameType::getName(), true));
-
-        /* call the method that calls the plugin kernel */
-        calculateEnergyParticles < CORE + BORDER > (currentStep);
+        /* call the method that writes the energies of the fused diagnostics */
+        calculateEnergyParticles(currentStep);
     }
 
   /** method used by plugin controller to get --help description **/
@@ -245,11 +118,12 @@ private:
     {
         if (notifyFrequency > 0) /* only if plugin is called at least once */
         {
-            /* decide which MPI-rank writes output: */
-            writeToFile = reduce.hasResult(mpi::reduceMethods::Reduce());
+            ParticleDiagnostics<ParticlesType>& diagnostics = ParticleDiagnostics<ParticlesType>::getInstance();
+            /* energies are summed in the particle sweep of all diagnostics of the species */
+            diagnostics.enable(particleDiagnostics::ENERGY, notifyFrequency);
 
-            /* create two ints on gpu and host: */
-            gEnergy = new GridBuffer<double, DIM1 > (DataSpace<DIM1 > (2));
+            /* decide which MPI-rank writes output: */
+            writeToFile = diagnostics.hasReducedResult();
 
             if (writeToFile) /* only MPI rank that writes to file: */
             {
@@ -280,6 +154,7 @@ private:
         {
             if (writeToFile)
             {
+                writeFinishedEnergies(true);
                 outFile.flush();
                 outFile << std::endl; /* now all data is written to file */
 
@@ -289,7 +164,7 @@ private:
                 outFile.close();
             }
 
-            __delete(gEnergy); /* free global memory on GPU */
+            ParticleDiagnostics<ParticlesType>::getInstance().disable(particleDiagnostics::ENERGY);
         }
     }
 
@@ -309,52 +184,48 @@ private:
         if( !writeToFile )
             return;
 
+        writeFinishedEnergies(true);
         checkpointTxtFile( outFile,
                            filename,
                            currentStep,
                            checkpointDirectory );
     }
 
-    /** method to call analysis and plugin-kernel calls **/
-    template< uint32_t AREA>
+    /** method to start the reduce of the energies of all GPUs **/
     void calculateEnergyParticles(uint32_t currentStep)
     {
-        KernelEnergyParticles kernelEnergyParticles;
-
-        gEnergy->getDeviceBuffer().setValue(0.0); /* init global energy with zero */
-        DataSpace<simDim> block(MappingDesc::SuperCellSize::toRT()); /* GPU parallelization */
-
-        /* kernel call = sum all particle energies on GPU */
-        __picKernelArea(
-            kernelEnergyParticles,
-            alpaka::dim::DimInt<simDim>,
-            *cellDescription,
-            AREA,
-            block)(
-                particles->getDeviceParticlesBox(),
-                gEnergy->getDeviceBuffer().getDataBox());
-
-        gEnergy->deviceToHost(); /* get energy from GPU */
+        /* kinetic and total energy summed over all particles,
+         * the sum over all GPUs is not blocking */
+        mpi::ReduceFuture<float_64> reducedEnergy =
+            ParticleDiagnostics<ParticlesType>::getInstance().getReducedSums(currentStep, particleDiagnostics::ENERGY);
 
-        double reducedEnergy[2]; /* create storage for kinetic and total energy */
+        if (writeToFile)
+            pendingEnergies.push_back(std::make_pair(currentStep, reducedEnergy));
 
-        /* add energies from all GPUs using MPI: */
-        reduce(nvidia::functors::Add(),
-               reducedEnergy,
-               gEnergy->getHostBuffer().getBasePointer(),
-               2,
-               mpi::reduceMethods::Reduce());
+        writeFinishedEnergies(false);
+    }
 
-        /* print timestep, kinetic energy and total energy to file: */
-        if (writeToFile)
+    /** write the energies of all finished reduces to file
+     *
+     * @param waitForAll block until all started reduces are finished
+     */
+    void writeFinishedEnergies(const bool waitForAll)
+    {
+        while (!pendingEnergies.empty() && (waitForAll || pendingEnergies.front().second.isFinished()))
         {
+            const uint32_t step = pendingEnergies.front().first;
+            const float_64* reducedEnergy = pendingEnergies.front().second.get();
+
+            /* print timestep, kinetic energy and total energy to file: */
             typedef std::numeric_limits< float_64 > dbl;
 
             outFile.precision(dbl::digits10);
-            outFile << currentStep << " "
+            outFile << step << " "
                     << std::scientific
-                    << reducedEnergy[0] * UNIT_ENERGY << " "
-                    << reducedEnergy[1] * UNIT_ENERGY << std::endl;
+                    << reducedEnergy[particleDiagnostics::ENERGY_KIN_IDX] * UNIT_ENERGY << " "
+                    << reducedEnergy[particleDiagnostics::ENERGY_IDX] * UNIT_ENERGY << std::endl;
+
+            pendingEnergies.pop_front();
         }
     }
 
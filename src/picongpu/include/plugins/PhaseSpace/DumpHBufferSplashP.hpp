@@ -25,6 +25,7 @@
 
 #include "simulation_defines.hpp"
 #include "plugins/PhaseSpace/AxisDescription.hpp"
+#include "plugins/hdf5/SplashLock.hpp"
 #include "communication/manager_common.h"
 #include "mappings/simulation/GridController.hpp"
 #include "mappings/simulation/SubGrid.hpp"
@@ -84,6 +85,9 @@ namespace picongpu
             int size;
             MPI_CHECK(MPI_Comm_size( mpiComm, &size ));
 
+            /** serialize with the asynchronous HDF5 output ******************/
+            std::lock_guard<std::mutex> lock(hdf5::splashMutex());
+
             /** create parallel domain collector ******************************/
             ParallelDomainCollector pdc(
                 mpiComm, MPI_INFO_NULL, Dimensions(size, 1, 1), 10 );
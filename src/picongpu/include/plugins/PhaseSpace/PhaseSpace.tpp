@@ -26,7 +26,6 @@
 #include "cuSTL/container/DeviceBuffer.hpp"
 #include "cuSTL/cursor/MultiIndexCursor.hpp"
 #include "cuSTL/algorithm/kernel/Foreach.hpp"
-#include "cuSTL/algorithm/kernel/ForeachBlock.hpp"
 #include "cuSTL/algorithm/mpi/Gather.hpp"
 #include "cuSTL/algorithm/mpi/Reduce.hpp"
 #include "cuSTL/algorithm/host/Foreach.hpp"
@@ -162,28 +161,25 @@ namespace picongpu
     template<uint32_t r_dir>
     void PhaseSpace<AssignmentFunction, Species>::calcPhaseSpace( )
     {
-        const PMacc::math::Int<simDim> guardCells = SuperCellSize().toRT() * int(GUARD_SIZE);
-        const PMacc::math::Size_t<simDim> coreBorderSuperCells( this->cellDescription->getGridSuperCells() - 2*int(GUARD_SIZE) );
-        const PMacc::math::Size_t<simDim> coreBorderCells = coreBorderSuperCells *
-            precisionCast<size_t>( SuperCellSize().toRT() );
-
-        /* select CORE + BORDER for all cells
-         * CORE + BORDER is contiguous, in cuSTL we call this a "topological spheric zone"
-         */
-        zone::SphericZone<simDim> zoneCoreBorder( coreBorderCells, guardCells );
-
-        algorithm::kernel::ForeachBlock<SuperCellSize> forEachSuperCell;
-
-        FunctorBlock<Species, SuperCellSize, float_PS, num_pbins, r_dir> functorBlock(
-            this->particles->getDeviceParticlesBox(), dBuffer->origin(),
-            this->axis_element.momentum, this->axis_p_range );
-
-        forEachSuperCell( /* area to work on */
-                          zoneCoreBorder,
-                          functorBlock,
-                          /* data below - passed to functor operator() */
-                          cursor::make_MultiIndexCursor<simDim>(),
-                        );
+        /* CORE + BORDER supercells which contain particles */
+        typename Species::ActiveSuperCellMapping mapper( this->particles->getActiveSuperCellMapping() );
+
+        /* x: momentum bin, y: spatial cell including the GUARD */
+        DataBox<PitchedBox<float_PS, DIM2> > phaseSpaceBox(
+            PitchedBox<float_PS, DIM2>( this->dBuffer->getDataPointer(),
+                                        this->dBuffer->getPitch()[0] ) );
+
+        KernelPhaseSpace<float_PS, num_pbins, r_dir> kernelPhaseSpace;
+        __cudaKernel(
+            kernelPhaseSpace,
+            alpaka::dim::DimInt<simDim>,
+            mapper.getGridDim(),
+            SuperCellSize::toRT())(
+                this->particles->getDeviceParticlesBox(),
+                phaseSpaceBox,
+                this->axis_element.momentum,
+                this->axis_p_range,
+                mapper);
     }
 
     template<class AssignmentFunction, class Species>
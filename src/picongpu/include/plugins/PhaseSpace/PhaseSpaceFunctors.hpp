@@ -22,13 +22,15 @@
 
 #include <utility>
 
-#include "cuSTL/cursor/MultiIndexCursor.hpp"
-#include "cuSTL/algorithm/cudaBlock/Foreach.hpp"
-#include "cuSTL/algorithm/kernel/ForeachBlock.hpp"
-#include "cuSTL/container/compile-time/SharedBuffer.hpp"
+#include "types.h"
+#include "simulation_defines.hpp"
+#include "dimensions/DataSpace.hpp"
+#include "dimensions/DataSpaceOperations.hpp"
+#include "mappings/kernel/ListMapping.hpp"
+#include "memory/boxes/DataBox.hpp"
+#include "memory/boxes/PitchedBox.hpp"
+#include "algorithms/Histogram.hpp"
 #include "math/Vector.hpp"
-#include "math/VectorOperations.hpp"
-#include "particles/access/Cell2Particle.hpp"
 
 #include "PhaseSpace.hpp"
 
@@ -36,175 +38,173 @@ namespace picongpu
 {
     using namespace PMacc;
 
-    /** Atomic Add Functor
+    /** Kernel to Run For Each SuperCell
      *
-     * \tparam Type of the values to perform a atomicAdd on
-     */
-    template<typename Type>
-    struct FunctorAtomicAdd
-    {
-        typedef void result_type;
-
-        DINLINE void
-        operator()( Type& dest, const Type src )
-        {
-            alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &dest, src );
-        }
-    };
-
-    /** Functor called for each particle
-     *
-     * Every particle in a frame of particles will end up here.
-     * We calculate where in space the owning (super) cell lives and
-     * add the particle to the shared memory buffer for that phase
-     * space snippet the super cell contributes to.
-     *
-     * \tparam r_dir spatial direction of the phase space (0,1,2) \see AxisDescription
-     * \tparam num_pbins number of bins in momentum space \see PhaseSpace.hpp
-     * \tparam SuperCellSize how many cells form a super cell \see memory.param
-     */
-    template<uint32_t r_dir, uint32_t num_pbins, typename SuperCellSize>
-    struct FunctorParticle
-    {
-        typedef void result_type;
-
-        /** Functor implementation
-         *
-         * \param frame current frame for this block
-         * \param particleID id of the particle in the current frame
-         * \param curDBufferOriginInBlock section of the phase space, shifted to the start of the block
-         * \param el_p coordinate of the momentum \see PhaseSpace::axis_element \see AxisDescription
-         * \param axis_p_range range of the momentum coordinate \see PhaseSpace::axis_p_range
-         */
-        template<typename FramePtr, typename float_PS, typename Pitch >
-        DINLINE void
-        operator()( FramePtr frame,
-                    uint16_t particleID,
-                    cursor::CT::BufferCursor<float_PS, Pitch> curDBufferOriginInBlock,
-                    const uint32_t el_p,
-                    const std::pair<float_X, float_X>& axis_p_range )
-        {
-            PMACC_AUTO( particle, (*frame)[particleID] );
-            /** \todo this can become a functor to be even more flexible */
-            const float_X mom_i = particle[momentum_][el_p];
-
-            /* cell id in this block */
-            const int linearCellIdx = particle[localCellIdx_];
-            const PMacc::math::UInt32<simDim> cellIdx(
-                PMacc::math::MapToPos<simDim>()( SuperCellSize(), linearCellIdx ) );
-
-            const uint32_t r_bin    = cellIdx[r_dir];
-            const float_X weighting = particle[weighting_];
-            const float_X charge    = attribute::getCharge( weighting,particle );
-            const float_PS particleChargeDensity =
-              precisionCast<float_PS>( charge / CELL_VOLUME );
-
-            const float_X rel_bin = (mom_i - axis_p_range.first)
-                                  / (axis_p_range.second - axis_p_range.first);
-            int p_bin = int( rel_bin * float_X(num_pbins) );
-
-            /* out-of-range bins back to min/max */
-            p_bin >= 0 ? /* do not change p_bin */ : p_bin=0;
-            p_bin < num_pbins ? /* do not change p_bin */ : p_bin=num_pbins-1;
-
-            /** \todo take particle shape into account */
-            alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &(*curDBufferOriginInBlock( p_bin, r_bin )),
-                              particleChargeDensity );
-        }
-    };
-
-    /** Functor to Run For Each SuperCell
-     *
-     * This functor is called for each super cell, preparing a shared memory
-     * buffer with a supercell-local (spatial) snippet of the phase space.
+     * Each block fills a privatized shared memory histogram with a
+     * supercell-local (spatial) snippet of the phase space.
      * Afterwards all blocks reduce their data to a combined gpu-local (spatial)
      * snippet of the phase space in global memory.
      *
-     * \tparam Species the particle species to create the phase space for
-     * \tparam SuperCellSize how many cells form a super cell \see memory.param
      * \tparam float_PS type for each bin in the phase space
      * \tparam num_pbins number of bins in momentum space \see PhaseSpace.hpp
      * \tparam r_dir spatial direction of the phase space (0,1,2) \see AxisDescription
      */
-    template<typename Species, typename SuperCellSize, typename float_PS, uint32_t num_pbins, uint32_t r_dir>
-    struct FunctorBlock
+    template<typename float_PS, uint32_t num_pbins, uint32_t r_dir>
+    struct KernelPhaseSpace
     {
-        typedef void result_type;
+        typedef PMacc::algorithms::histogram::BlockHistogram<float_PS, DIM2> Histogram;
 
-        typedef typename Species::ParticlesBoxType TParticlesBox;
-
-        TParticlesBox particlesBox;
-        cursor::BufferCursor<float_PS, 2> curOriginPhaseSpace;
-        uint32_t p_element;
-        std::pair<float_X, float_X> axis_p_range;
+        /** number of bins of a block: momentum x cells of a supercell in r_dir */
+        template<typename SuperCellSize>
+        HDINLINE static DataSpace<DIM2> getNumBins()
+        {
+            return DataSpace<DIM2>(num_pbins, SuperCellSize::template at<r_dir>::type::value);
+        }
 
-        /** Constructor to transfer params to device
+        /** Kernel implementation
          *
          * \param pb ParticleBox for a species
-         * \param cur cursor to start of the local phase space in global memory
-         * \param p_dir direction of the 2D phase space in momentum \see AxisDescription
-         * \param p_range range of the momentum axis \see PhaseSpace::axis_p_range
-         */
-        HDINLINE
-        FunctorBlock( const TParticlesBox& pb,
-                      cursor::BufferCursor<float_PS, 2> cur,
-                      const uint32_t p_dir,
-                      const std::pair<float_X, float_X>& p_range ) :
-        particlesBox(pb), curOriginPhaseSpace(cur), p_element(p_dir),
-        axis_p_range(p_range)
-        {}
-
-        /** Called for the first cell of each block #-of-cells-in-block times
-         *
-         * \param indexBlockOffset cell index in global memory, describes where
-         *                         the current block starts
-         *                         \see cuSTL/algorithm/kernel/ForeachBlock.hpp
+         * \param phaseSpaceBox local phase space in global memory, x is the
+         *                      momentum bin and y the spatial cell
+         * \param el_p coordinate of the momentum \see PhaseSpace::axis_element \see AxisDescription
+         * \param axis_p_range range of the momentum coordinate \see PhaseSpace::axis_p_range
+         * \param mapper mapping of the active supercells
          */
-        DINLINE void
-        operator()( const PMacc::math::Int<simDim>& indexBlockOffset )
+        template<
+            typename T_Acc,
+            typename ParBox,
+            typename PhaseSpaceBox,
+            typename Mapping>
+        ALPAKA_FN_ACC void operator()(
+            T_Acc const & acc,
+            ParBox const & pb,
+            PhaseSpaceBox const & phaseSpaceBox,
+            uint32_t const & el_p,
+            std::pair<float_X, float_X> const & axis_p_range,
+            Mapping const & mapper) const
         {
-            /** \todo write math::Vector constructor that supports dim3 */
-            const PMacc::math::Int<simDim> indexGlobal = indexBlockOffset;
+            typedef typename ParBox::FrameType FRAME;
+            typedef typename Mapping::SuperCellSize SuperCellSize;
+            const int threads = PMacc::math::CT::volume<SuperCellSize>::type::value;
 
-            /* create shared mem */
-            const int blockCellsInDir = SuperCellSize::template at<r_dir>::type::value;
-            typedef typename PMacc::math::CT::Int<num_pbins, blockCellsInDir> dBufferSizeInBlock;
-            container::CT::SharedBuffer<float_PS, dBufferSizeInBlock > dBufferInBlock;
+            DataSpace<simDim> const blockIndex(alpaka::idx::getIdx<alpaka::Grid, alpaka::Blocks>(acc));
+            DataSpace<simDim> const threadIndex(alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc));
 
-            /* init shared mem */
-            PMacc::algorithm::cudaBlock::Foreach<SuperCellSize> forEachThreadInBlock;
+            auto frame(alpaka::block::shared::allocVar<FRAME *>(acc));
+            auto isValid(alpaka::block::shared::allocVar<bool>(acc));
+            auto particlesInSuperCell(alpaka::block::shared::allocVar<lcellId_t>(acc));
+
+            const int linearThreadIdx = DataSpaceOperations<simDim>::template map<SuperCellSize > (threadIndex);
+
+            const Histogram histogram(acc.template getBlockSharedExternMem<float_PS>(),
+                                      getNumBins<SuperCellSize>(),
+                                      linearThreadIdx,
+                                      threads);
+
+            /* superCellIdx includes the guarding supercells */
+            forEachMappedSuperCell(acc, mapper, blockIndex, [&](DataSpace<simDim> const & superCellIdx)
             {
-                using namespace lambda;
-                DECLARE_PLACEHOLDERS();
-                forEachThreadInBlock( dBufferInBlock.zone(),
-                                      _1 = float_PS(0.0),
-                                      dBufferInBlock.origin(),
-                );
-            }
-            alpaka::block::sync::syncBlockThreads(acc);
-
-            FunctorParticle<r_dir, num_pbins, SuperCellSize> functorParticle;
-            particleAccess::Cell2Particle<SuperCellSize> forEachParticleInCell;
-            forEachParticleInCell( /* mandatory params */
-                                   particlesBox, indexGlobal, functorParticle,
-                                   /* optional params */
-                                   dBufferInBlock.origin(),
-                                   p_element,
-                                   axis_p_range
-                                 );
-
-            alpaka::block::sync::syncBlockThreads(acc);
-            /* add to global dBuffer */
-            forEachThreadInBlock( /* area to work on */
-                                  dBufferInBlock.zone(),
-                                 /* functor */
-                                  FunctorAtomicAdd<float_PS>(),
-                                  /* data below - cursors will be shifted and
-                                   * dereferenced */
-                                  curOriginPhaseSpace(0, indexBlockOffset[r_dir]),
-                                  dBufferInBlock.origin()
-            );
+                if (linearThreadIdx == 0)
+                {
+                    frame = &(pb.getLastFrame(superCellIdx, isValid));
+                    particlesInSuperCell = pb.getSuperCell(superCellIdx).getSizeLastFrame();
+                }
+                histogram.init(acc);
+
+                alpaka::block::sync::syncBlockThreads(acc);
+                if (!isValid)
+                    return; /* end supercell if we have no frames */
+
+                while (isValid)
+                {
+                    /* frames can contain gaps */
+                    if (linearThreadIdx < particlesInSuperCell && (*frame)[linearThreadIdx][multiMask_] == 1)
+                    {
+                        PMACC_AUTO( particle, (*frame)[linearThreadIdx] );
+                        /** \todo this can become a functor to be even more flexible */
+                        const float_X mom_i = particle[momentum_][el_p];
+
+                        /* cell id in this block */
+                        const int linearCellIdx = particle[localCellIdx_];
+                        const PMacc::math::UInt32<simDim> cellIdx(
+                            PMacc::math::MapToPos<simDim>()( SuperCellSize(), linearCellIdx ) );
+
+                        const uint32_t r_bin    = cellIdx[r_dir];
+                        const float_X weighting = particle[weighting_];
+                        const float_X charge    = attribute::getCharge( weighting,particle );
+                        const float_PS particleChargeDensity =
+                          precisionCast<float_PS>( charge / CELL_VOLUME );
+
+                        const float_X rel_bin = (mom_i - axis_p_range.first)
+                                              / (axis_p_range.second - axis_p_range.first);
+                        int p_bin = int( rel_bin * float_X(num_pbins) );
+
+                        /* out-of-range bins back to min/max */
+                        p_bin >= 0 ? /* do not change p_bin */ : p_bin=0;
+                        p_bin < num_pbins ? /* do not change p_bin */ : p_bin=num_pbins-1;
+
+                        /** \todo take particle shape into account */
+                        histogram.add(acc, DataSpace<DIM2>(p_bin, r_bin), particleChargeDensity);
+                    }
+                    alpaka::block::sync::syncBlockThreads(acc);
+                    if (linearThreadIdx == 0)
+                    {
+                        frame = &(pb.getPreviousFrame(*frame, isValid));
+                        particlesInSuperCell = threads;
+                    }
+                    alpaka::block::sync::syncBlockThreads(acc);
+                }
+
+                /* add to global dBuffer */
+                const int blockCellsInDir = SuperCellSize::template at<r_dir>::type::value;
+                histogram.combine(acc, phaseSpaceBox.shift(DataSpace<DIM2>(0, superCellIdx[r_dir] * blockCellsInDir)));
+            });
         }
     };
 
 } // namespace picongpu
+
+namespace alpaka
+{
+    namespace kernel
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The trait for getting the size of the block shared extern memory for a kernel.
+            //#############################################################################
+            template<
+                typename float_PS,
+                uint32_t num_pbins,
+                uint32_t r_dir,
+                typename T_Acc>
+            struct BlockSharedExternMemSizeBytes<
+                picongpu::KernelPhaseSpace<float_PS, num_pbins, r_dir>,
+                T_Acc>
+            {
+                //-----------------------------------------------------------------------------
+                //! \return The size of the shared memory allocated for a block.
+                //-----------------------------------------------------------------------------
+                template<
+                    typename TDim,
+                    typename ParBox,
+                    typename PhaseSpaceBox,
+                    typename Mapping>
+                ALPAKA_FN_HOST static auto getBlockSharedExternMemSizeBytes(
+                    alpaka::Vec<TDim, alpaka::size::Size<T_Acc>> const & vuiBlockThreadsExtents,
+                    ParBox const & pb,
+                    PhaseSpaceBox const & phaseSpaceBox,
+                    uint32_t const & el_p,
+                    std::pair<picongpu::float_X, picongpu::float_X> const & axis_p_range,
+                    Mapping const & mapper)
+                -> alpaka::size::Size<T_Acc>
+                {
+                    typedef picongpu::KernelPhaseSpace<float_PS, num_pbins, r_dir> Kernel;
+                    return Kernel::Histogram::getSharedMemSizeBytes(
+                        Kernel::template getNumBins<typename Mapping::SuperCellSize>(),
+                        vuiBlockThreadsExtents.prod());
+                }
+            };
+        }
+    }
+}
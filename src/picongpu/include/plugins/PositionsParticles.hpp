@@ -29,10 +29,9 @@
 #include "simulation_types.hpp"
 
 #include "simulation_classTypes.hpp"
-#include "mappings/kernel/AreaMapping.hpp"
 
-#include "algorithms/Gamma.hpp"
 #include "plugins/ILightweightPlugin.hpp"
+#include "plugins/particleDiagnostics/ParticleDiagnostics.hpp"
 
 namespace picongpu
 {
@@ -40,135 +39,6 @@ using namespace PMacc;
 
 namespace po = boost::program_options;
 
-template<class FloatPos>
-struct SglParticle
-{
-    FloatPos position;
-    float3_X momentum;
-    float_X mass;
-    float_X weighting;
-    float_X charge;
-    float_X gamma;
-
-    SglParticle() : position(FloatPos::create(0.0)), momentum(float3_X::create(0.0)), mass(0.0),
-        weighting(0.0), charge(0.0), gamma(0.0)
-    {
-    }
-
-    DataSpace<simDim> globalCellOffset;
-
-    //! todo
-
-    floatD_64 getGlobalCell() const
-    {
-        floatD_64 doubleGlobalCellOffset;
-        for(uint32_t i=0;i<simDim;++i)
-            doubleGlobalCellOffset[i]=float_64(globalCellOffset[i]);
-
-        return floatD_64( doubleGlobalCellOffset+ precisionCast<float_64>(position));
-    }
-
-    template<typename T>
-        friend std::ostream& operator<<(std::ostream& out, const SglParticle<T>& v)
-    {
-        floatD_64 pos;
-        for(uint32_t i=0;i<simDim;++i)
-            pos[i]=( v.getGlobalCell()[i] * cellSize[i]*UNIT_LENGTH);
-
-        const float3_64 mom( precisionCast<float_64>(v.momentum.x()) * UNIT_MASS * UNIT_SPEED,
-                             precisionCast<float_64>(v.momentum.y()) * UNIT_MASS * UNIT_SPEED,
-                             precisionCast<float_64>(v.momentum.z()) * UNIT_MASS * UNIT_SPEED );
-
-        const float_64 mass = precisionCast<float_64>(v.mass) * UNIT_MASS;
-        const float_64 charge = precisionCast<float_64>(v.charge) * UNIT_CHARGE;
-
-        typedef std::numeric_limits< float_64 > dbl;
-        out.precision(dbl::digits10);
-
-        out << std::scientific << pos << " " << mom << " " << mass << " "
-            << precisionCast<float_64>(v.weighting)
-            << " " << charge << " " << precisionCast<float_64>(v.gamma);
-        return out;
-    }
-};
-
-/** write the position of a single particle to a file
- * \warning this analyser MUST NOT be used with more than one (global!)
- * particle and is created for one-particle-test-purposes only
- */
-struct KernelPositionsParticles
-{
-template<
-    typename T_Acc,
-    typename FRAME,
-    typename FloatPos,
-    typename Mapping>
-ALPAKA_FN_ACC void operator()(
-    T_Acc const & acc,
-    ParticlesBox<FRAME, simDim> const & pb,
-    SglParticle<FloatPos>* gParticle,
-    Mapping const & mapper) const
-{
-    DataSpace<simDim> const blockIndex(alpaka::idx::getIdx<alpaka::Grid, alpaka::Blocks>(acc));
-    DataSpace<simDim> const threadIndex(alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc));
-
-    auto frame(alpaka::block::shared::allocVar<FRAME *>(acc));
-    auto isValid(alpaka::block::shared::allocVar<bool>(acc));
-
-    alpaka::block::sync::syncBlockThreads(acc); /*wait that all shared memory is initialised*/
-
-    typedef typename Mapping::SuperCellSize SuperCellSize;
-
-    const int linearThreadIdx = DataSpaceOperations<simDim>::template map<SuperCellSize > (threadIndex);
-    const DataSpace<simDim> superCellIdx(mapper.getSuperCellIndex(DataSpace<simDim > (blockIndex)));
-
-    if (linearThreadIdx == 0)
-    {
-        frame = &(pb.getLastFrame(superCellIdx, isValid));
-    }
-
-    alpaka::block::sync::syncBlockThreads(acc);
-    if (!isValid)
-        return; //end kernel if we have no frames
-
-    /* BUGFIX to issue #538
-     * volatile prohibits that the compiler creates wrong code*/
-    volatile bool isParticle = (*frame)[linearThreadIdx][multiMask_];
-
-    while (isValid)
-    {
-        if (isParticle)
-        {
-            PMACC_AUTO(particle,(*frame)[linearThreadIdx]);
-            gParticle->position = particle[position_];
-            gParticle->momentum = particle[momentum_];
-            gParticle->weighting = particle[weighting_];
-            gParticle->mass = attribute::getMass(gParticle->weighting,particle);
-            gParticle->charge = attribute::getCharge(gParticle->weighting,particle);
-            gParticle->gamma = Gamma<>()(gParticle->momentum, gParticle->mass);
-
-            // storage number in the actual frame
-            const lcellId_t frameCellNr = particle[localCellIdx_];
-
-            // offset in the actual superCell = cell offset in the supercell
-            const DataSpace<simDim> frameCellOffset(DataSpaceOperations<simDim>::template map<MappingDesc::SuperCellSize > (frameCellNr));
-
-
-            gParticle->globalCellOffset = (superCellIdx - mapper.getGuardingSuperCells())
-                * MappingDesc::SuperCellSize::toRT()
-                + frameCellOffset;
-        }
-        alpaka::block::sync::syncBlockThreads(acc);
-        if (linearThreadIdx == 0)
-        {
-            frame = &(pb.getPreviousFrame(*frame, isValid));
-        }
-        isParticle = true;
-        alpaka::block::sync::syncBlockThreads(acc);
-    }
-}
-};
-
 template<class ParticlesType>
 class PositionsParticles : public ILightweightPlugin
 {
@@ -176,10 +46,6 @@ private:
     typedef MappingDesc::SuperCellSize SuperCellSize;
     typedef floatD_X FloatPos;
 
-    ParticlesType *particles;
-
-    GridBuffer<SglParticle<FloatPos>, DIM1> *gParticle;
-
     MappingDesc *cellDescription;
     uint32_t notifyFrequency;
 
@@ -191,8 +57,6 @@ public:
     PositionsParticles() :
     analyzerName("PositionsParticles: write position of one particle of a species to std::cout"),
     analyzerPrefix(ParticlesType::FrameType::getName() + std::string("_position")),
-    particles(NULL),
-    gParticle(NULL),
     cellDescription(NULL),
     notifyFrequency(0)
     {
@@ -204,13 +68,10 @@ public:
 
     void notify(uint32_t currentStep)
     {
-        DataConnector &dc = Environment<>::get().DataConnector();
-
-        particles = &(dc.getData<ParticlesType > (ParticlesType::FrameType::getName(), true));
-
-
         const int rank = Environment<simDim>::get().GridController().getGlobalRank();
-        const SglParticle<FloatPos> positionParticle = getPositionsParticles < CORE + BORDER > (currentStep);
+        /* the particle is picked in the particle sweep of all diagnostics of the species */
+        const SglParticle<FloatPos> positionParticle =
+            ParticleDiagnostics<ParticlesType>::getInstance().getPositionParticle(currentStep);
 
         /*FORMAT OUTPUT*/
         if (positionParticle.mass != float_X(0.0))
@@ -242,8 +103,7 @@ private:
     {
         if (notifyFrequency > 0)
         {
-            //create one float3_X on gpu und host
-            gParticle = new GridBuffer<SglParticle<FloatPos>, DIM1 > (DataSpace<DIM1 > (1));
+            ParticleDiagnostics<ParticlesType>::getInstance().enable(particleDiagnostics::POSITION, notifyFrequency);
 
             Environment<>::get().PluginConnector().setNotificationPeriod(this, notifyFrequency);
         }
@@ -251,41 +111,8 @@ private:
 
     void pluginUnload()
     {
-        __delete(gParticle);
-    }
-
-    template< uint32_t AREA>
-    SglParticle<FloatPos> getPositionsParticles(uint32_t currentStep)
-    {
-
-        typedef typename MappingDesc::SuperCellSize SuperCellSize;
-        SglParticle<FloatPos> positionParticleTmp;
-
-        gParticle->getDeviceBuffer().setValue(positionParticleTmp);
-        DataSpace<simDim> block(SuperCellSize::toRT());
-
-        KernelPositionsParticles kernelPositionsParticles;
-        __picKernelArea(
-            kernelPositionsParticles,
-            alpaka::dim::DimInt<simDim>,
-            *cellDescription,
-            AREA,
-            block)(
-                particles->getDeviceParticlesBox(),
-                gParticle->getDeviceBuffer().getBasePointer());
-
-        gParticle->deviceToHost();
-
-        DataSpace<simDim> localSize(cellDescription->getGridLayout().getDataSpaceWithoutGuarding());
-        const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
-
-        DataSpace<simDim> gpuPhyCellOffset(Environment<simDim>::get().SubGrid().getLocalDomain().offset);
-        gpuPhyCellOffset.y() += (localSize.y() * numSlides);
-
-        gParticle->getHostBuffer().getDataBox()[0].globalCellOffset += gpuPhyCellOffset;
-
-
-        return gParticle->getHostBuffer().getDataBox()[0];
+        if (notifyFrequency > 0)
+            ParticleDiagnostics<ParticlesType>::getInstance().disable(particleDiagnostics::POSITION);
     }
 
 };
@@ -72,6 +72,7 @@
 #include "plugins/adios/ADIOSCountParticles.hpp"
 #include "plugins/adios/restart/LoadSpecies.hpp"
 #include "plugins/adios/restart/RestartFieldLoader.hpp"
+#include "fields/background/CheckpointBackground.hpp"
 
 
 namespace picongpu
@@ -576,10 +577,33 @@ public:
         mThreadParams.window = MovingWindow::getInstance().getDomainAsWindow(restartStep);
         mThreadParams.localWindowToDomainOffset = DataSpace<simDim>::create(0);
 
+        /* files without the attribute contain the background (old format) */
+        uint32_t fieldsContainBackground = 1;
+        void* bgPtr = NULL;
+        int bgSize;
+        enum ADIOS_DATATYPES bgType;
+        if (adios_get_attr( mThreadParams.fp,
+                            (mThreadParams.adiosBasePath +
+                             std::string(fieldBackground::containedAttributeName)).c_str(),
+                            &bgType,
+                            &bgSize,
+                            &bgPtr ) == ADIOS_SUCCESS)
+        {
+            assert(bgType == adiosUInt32Type.type);
+            fieldsContainBackground = *( (uint32_t*)bgPtr );
+            free(bgPtr);
+        }
+        else
+            log<picLog::INPUT_OUTPUT > ("ADIOS: no attribute %1%, fields are restarted with background") %
+                fieldBackground::containedAttributeName;
+
         /* load all fields */
         ForEach<FileCheckpointFields, LoadFields<bmpl::_1> > forEachLoadFields;
         forEachLoadFields(&mThreadParams);
 
+        if (fieldsContainBackground != 0)
+            fieldBackground::removeAfterRestart(*cellDescription, restartStep);
+
         /* load all particles */
         ForEach<FileCheckpointParticles, LoadSpecies<bmpl::_1> > forEachLoadSpecies;
         forEachLoadSpecies(&mThreadParams, restartChunkSize);
@@ -834,6 +858,13 @@ private:
                   "sim_slides", threadParams->adiosBasePath.c_str(), adiosUInt32Type.type,
                   int2str(slides).c_str(), ""));
 
+        /* write if E and B contain the background fields */
+        log<picLog::INPUT_OUTPUT > ("ADIOS: meta: %1%") % fieldBackground::containedAttributeName;
+        ADIOS_CMD(adios_define_attribute(threadParams->adiosGroupHandle,
+                  fieldBackground::containedAttributeName, threadParams->adiosBasePath.c_str(),
+                  adiosUInt32Type.type,
+                  int2str(fieldBackground::containedInFile(threadParams->isCheckpoint)).c_str(), ""));
+
         /* write normed grid parameters */
         log<picLog::INPUT_OUTPUT > ("ADIOS: meta: grid");
         ADIOS_CMD(adios_define_attribute(threadParams->adiosGroupHandle,
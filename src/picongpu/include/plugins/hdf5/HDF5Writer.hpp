@@ -21,7 +21,7 @@
 
 #pragma once
 
-#include <pthread.h>
+#include <thread>
 #include <cassert>
 #include <sstream>
 #include <list>
@@ -31,6 +31,7 @@
 #include "simulation_types.hpp"
 #include "simulation_defines.hpp"
 #include "plugins/hdf5/HDF5Writer.def"
+#include "plugins/hdf5/SplashLock.hpp"
 
 #include "particles/frame_types.hpp"
 
@@ -67,6 +68,7 @@
 #include "plugins/hdf5/WriteSpecies.hpp"
 #include "plugins/hdf5/restart/LoadSpecies.hpp"
 #include "plugins/hdf5/restart/RestartFieldLoader.hpp"
+#include "fields/background/CheckpointBackground.hpp"
 #include "memory/boxes/DataBoxDim1Access.hpp"
 
 namespace picongpu
@@ -94,7 +96,9 @@ public:
     filename("h5_data"),
     checkpointFilename("h5_checkpoint"),
     restartFilename(""), /* set to checkpointFilename by default */
-    notifyPeriod(0)
+    notifyPeriod(0),
+    asyncWrite(false),
+    ioComm(MPI_COMM_NULL)
     {
         Environment<>::get().PluginConnector().registerPlugin(this);
     }
@@ -115,6 +119,9 @@ public:
              "Optional HDF5 checkpoint filename (prefix)")
             ("hdf5.restart-file", po::value<std::string > (&restartFilename),
              "HDF5 restart filename (prefix)")
+            ("hdf5.async", po::bool_switch(&asyncWrite),
+             "write HDF5 output (not checkpoints) from a host snapshot in a background thread "
+             "(needs MPI_THREAD_MULTIPLE and twice the host memory of the output data)")
             /* 1,000,000 particles are around 3900 frames at 256 particles per frame
              * and match ~30MiB with typical picongpu particles.
              * The only reason why we use 1M particles per chunk is that we can get a
@@ -212,10 +219,27 @@ public:
 
         ThreadParams *params = &mThreadParams;
 
+        /* files without the attribute contain the background (old format) */
+        uint32_t fieldsContainBackground = 1;
+        try
+        {
+            mThreadParams.dataCollector->readAttribute(restartStep, NULL,
+                                                       fieldBackground::containedAttributeName,
+                                                       &fieldsContainBackground);
+        }
+        catch (DCException e)
+        {
+            log<picLog::INPUT_OUTPUT > ("HDF5 no attribute %1%, fields are restarted with background") %
+                fieldBackground::containedAttributeName;
+        }
+
         /* load all fields */
         ForEach<FileCheckpointFields, LoadFields<bmpl::_1> > forEachLoadFields;
         forEachLoadFields(params);
 
+        if (fieldsContainBackground != 0)
+            fieldBackground::removeAfterRestart(*cellDescription, restartStep);
+
         /* load all particles */
         ForEach<FileCheckpointParticles, LoadSpecies<bmpl::_1> > forEachLoadSpecies;
         forEachLoadSpecies(params, restartChunkSize);
@@ -248,8 +272,11 @@ private:
         if (mThreadParams.dataCollector == NULL)
         {
             GridController<simDim> &gc = Environment<simDim>::get().GridController();
+            /* the I/O thread needs an own communicator, MPI calls of the
+             * simulation can run at the same time */
+            MPI_Comm comm = asyncWrite ? ioComm : gc.getCommunicator().getMPIComm();
             mThreadParams.dataCollector = new ParallelDomainCollector(
-                                                                      gc.getCommunicator().getMPIComm(),
+                                                                      comm,
                                                                       gc.getCommunicator().getMPIInfo(),
                                                                       splashMpiSize,
                                                                       maxOpenFilesPerNode);
@@ -284,6 +311,10 @@ private:
     void notificationReceived(uint32_t currentStep, bool isCheckpoint)
     {
         const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
+
+        /* at most one write in flight: wait if the last dump is not finished */
+        waitForWriteThread();
+
         mThreadParams.isCheckpoint = isCheckpoint;
         mThreadParams.currentStep = currentStep;
         mThreadParams.cellDescription = this->cellDescription;
@@ -321,13 +352,52 @@ private:
             }
         }
 
-        openH5File(fname);
+        /* checkpoints must be complete before the simulation continues */
+        mThreadParams.isAsync = asyncWrite && !isCheckpoint;
 
-        writeHDF5((void*) &mThreadParams);
+        if (mThreadParams.isAsync)
+        {
+            /* copy all output data to a host snapshot, the I/O thread writes it */
+            writeHDF5(&mThreadParams);
+            ioThread = std::thread(&HDF5Writer::writeStagedData, this, fname);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(splashMutex());
+
+            openH5File(fname);
+
+            writeHDF5(&mThreadParams);
+
+            closeH5File();
+        }
+    }
 
+    /**
+     * Write the staged snapshot (executed by the I/O thread)
+     *
+     * @param h5Filename file name (prefix)
+     */
+    void writeStagedData(const std::string h5Filename)
+    {
+        /* other plugins wait until the snapshot is written */
+        std::lock_guard<std::mutex> lock(splashMutex());
+
+        openH5File(h5Filename);
+        mThreadParams.flushWriteQueue();
         closeH5File();
     }
 
+    /** wait until the I/O thread finished writing the last snapshot */
+    void waitForWriteThread()
+    {
+        if (ioThread.joinable())
+        {
+            log<picLog::INPUT_OUTPUT > ("HDF5: wait for last asynchronous write");
+            ioThread.join();
+        }
+    }
+
     void pluginLoad()
     {
         GridController<simDim> &gc = Environment<simDim>::get().GridController();
@@ -360,61 +430,96 @@ private:
             restartFilename = checkpointFilename;
         }
 
+        if (asyncWrite)
+        {
+            int provided = MPI_THREAD_SINGLE;
+            MPI_CHECK(MPI_Query_thread(&provided));
+            log<picLog::INPUT_OUTPUT > ("HDF5: MPI thread support level %1% (MPI_THREAD_MULTIPLE is %2%)") %
+                provided % MPI_THREAD_MULTIPLE;
+            if (provided < MPI_THREAD_MULTIPLE)
+            {
+                log<picLog::INPUT_OUTPUT > ("HDF5: asynchronous write disabled, MPI_THREAD_MULTIPLE is not provided");
+                asyncWrite = false;
+            }
+            else
+                MPI_CHECK(MPI_Comm_dup(gc.getCommunicator().getMPIComm(), &ioComm));
+        }
+
         loaded = true;
     }
 
     void pluginUnload()
     {
+        waitForWriteThread();
+
         if (mThreadParams.dataCollector)
             mThreadParams.dataCollector->finalize();
 
         __delete(mThreadParams.dataCollector);
+
+        if (ioComm != MPI_COMM_NULL)
+            MPI_CHECK(MPI_Comm_free(&ioComm));
     }
 
     typedef PICToSplash<float_X>::type SplashFloatXType;
 
     static void writeMetaAttributes(ThreadParams *threadParams)
     {
-        ColTypeUInt32 ctUInt32;
-        ColTypeDouble ctDouble;
-        SplashFloatXType splashFloatXType;
-
-        ParallelDomainCollector *dc = threadParams->dataCollector;
-        uint32_t currentStep = threadParams->currentStep;
+        const uint32_t currentStep = threadParams->currentStep;
 
-        /* write number of slides */
-        const uint32_t slides = MovingWindow::getInstance().getSlideCounter(threadParams->currentStep);
+        /* number of slides */
+        const uint32_t slides = MovingWindow::getInstance().getSlideCounter(currentStep);
 
-        dc->writeAttribute(threadParams->currentStep,
-                           ctUInt32, NULL, "sim_slides", &slides);
+        const uint32_t fieldsContainBackground = fieldBackground::containedInFile(threadParams->isCheckpoint);
 
-        /* write normed grid parameters */
-        dc->writeAttribute(currentStep, splashFloatXType, NULL, "delta_t", &DELTA_T);
-        dc->writeAttribute(currentStep, splashFloatXType, NULL, "cell_width", &CELL_WIDTH);
-        dc->writeAttribute(currentStep, splashFloatXType, NULL, "cell_height", &CELL_HEIGHT);
-        if (simDim == DIM3)
+        threadParams->enqueue([=](ThreadParams *p)
         {
-            dc->writeAttribute(currentStep, splashFloatXType, NULL, "cell_depth", &CELL_DEPTH);
-        }
+            ColTypeUInt32 ctUInt32;
+            ColTypeDouble ctDouble;
+            SplashFloatXType splashFloatXType;
+
+            ParallelDomainCollector *dc = p->dataCollector;
+
+            /* write number of slides */
+            dc->writeAttribute(currentStep,
+                               ctUInt32, NULL, "sim_slides", &slides);
+
+            /* write if E and B contain the background fields */
+            dc->writeAttribute(currentStep, ctUInt32, NULL,
+                               fieldBackground::containedAttributeName, &fieldsContainBackground);
+
+            /* write normed grid parameters */
+            dc->writeAttribute(currentStep, splashFloatXType, NULL, "delta_t", &DELTA_T);
+            dc->writeAttribute(currentStep, splashFloatXType, NULL, "cell_width", &CELL_WIDTH);
+            dc->writeAttribute(currentStep, splashFloatXType, NULL, "cell_height", &CELL_HEIGHT);
+            if (simDim == DIM3)
+            {
+                dc->writeAttribute(currentStep, splashFloatXType, NULL, "cell_depth", &CELL_DEPTH);
+            }
 
-        /* write base units */
-        dc->writeAttribute(currentStep, ctDouble, NULL, "unit_energy", &UNIT_ENERGY);
-        dc->writeAttribute(currentStep, ctDouble, NULL, "unit_length", &UNIT_LENGTH);
-        dc->writeAttribute(currentStep, ctDouble, NULL, "unit_speed", &UNIT_SPEED);
-        dc->writeAttribute(currentStep, ctDouble, NULL, "unit_time", &UNIT_TIME);
-        dc->writeAttribute(currentStep, ctDouble, NULL, "unit_mass", &UNIT_MASS);
-        dc->writeAttribute(currentStep, ctDouble, NULL, "unit_charge", &UNIT_CHARGE);
-        dc->writeAttribute(currentStep, ctDouble, NULL, "unit_efield", &UNIT_EFIELD);
-        dc->writeAttribute(currentStep, ctDouble, NULL, "unit_bfield", &UNIT_BFIELD);
-
-        /* write physical constants */
-        dc->writeAttribute(currentStep, splashFloatXType, NULL, "mue0", &MUE0);
-        dc->writeAttribute(currentStep, splashFloatXType, NULL, "eps0", &EPS0);
+            /* write base units */
+            dc->writeAttribute(currentStep, ctDouble, NULL, "unit_energy", &UNIT_ENERGY);
+            dc->writeAttribute(currentStep, ctDouble, NULL, "unit_length", &UNIT_LENGTH);
+            dc->writeAttribute(currentStep, ctDouble, NULL, "unit_speed", &UNIT_SPEED);
+            dc->writeAttribute(currentStep, ctDouble, NULL, "unit_time", &UNIT_TIME);
+            dc->writeAttribute(currentStep, ctDouble, NULL, "unit_mass", &UNIT_MASS);
+            dc->writeAttribute(currentStep, ctDouble, NULL, "unit_charge", &UNIT_CHARGE);
+            dc->writeAttribute(currentStep, ctDouble, NULL, "unit_efield", &UNIT_EFIELD);
+            dc->writeAttribute(currentStep, ctDouble, NULL, "unit_bfield", &UNIT_BFIELD);
+
+            /* write physical constants */
+            dc->writeAttribute(currentStep, splashFloatXType, NULL, "mue0", &MUE0);
+            dc->writeAttribute(currentStep, splashFloatXType, NULL, "eps0", &EPS0);
+        });
     }
 
-    static void *writeHDF5(void *p_args)
+    /**
+     * Write (or stage if threadParams->isAsync) all output data
+     *
+     * @param threadParams parameters of the dump
+     */
+    static void writeHDF5(ThreadParams *threadParams)
     {
-        ThreadParams *threadParams = (ThreadParams*) (p_args);
         const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
 
         writeMetaAttributes(threadParams);
@@ -450,8 +555,6 @@ private:
             writeSpecies(threadParams, std::string(), particleOffset);
         }
         log<picLog::INPUT_OUTPUT > ("HDF5: ( end ) writing particle species.");
-
-        return NULL;
     }
 
     ThreadParams mThreadParams;
@@ -467,6 +570,13 @@ private:
 
     uint32_t restartChunkSize;
 
+    /** write output asynchronously (command line option) */
+    bool asyncWrite;
+    /** thread writing the last snapshot */
+    std::thread ioThread;
+    /** communicator of the dataCollector for asynchronous writes */
+    MPI_Comm ioComm;
+
     DataSpace<simDim> mpi_pos;
     DataSpace<simDim> mpi_size;
 
@@ -0,0 +1,44 @@
+/**
+ * Copyright 2026 agent
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <mutex>
+
+namespace picongpu
+{
+namespace hdf5
+{
+
+/** mutex of all libSplash calls of this process
+ *
+ * HDF5 is usually built without thread safety. The asynchronous HDF5Writer
+ * writes from an I/O thread while other plugins use libSplash on the main
+ * thread, therefore each libSplash use (including the construction and
+ * destruction of a DataCollector) must hold this mutex.
+ */
+inline std::mutex& splashMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+} //namespace hdf5
+} //namespace picongpu
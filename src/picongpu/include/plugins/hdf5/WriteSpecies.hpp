@@ -47,6 +47,9 @@
 #include "compileTime/conversion/RemoveFromSeq.hpp"
 #include "particles/ParticleDescription.hpp"
 
+#include <memory>
+#include <vector>
+
 namespace picongpu
 {
 
@@ -143,7 +146,8 @@ public:
             DataSpace<simDim> block(PMacc::math::CT::volume<SuperCellSize>::type::value);
 
             GridBuffer<int, DIM1> counterBuffer(DataSpace<DIM1>(1));
-            AreaMapping < CORE + BORDER, MappingDesc > mapper(*(params->cellDescription));
+            /* only supercells of CORE + BORDER which contain particles */
+            typename ThisSpecies::ActiveSuperCellMapping mapper(speciesTmp->getActiveSuperCellMapping());
 
             KernelCopySpecies kernelCopySpecies;
             __cudaKernel(
@@ -175,7 +179,6 @@ public:
         /*write species counter table to hdf5 file*/
         log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) writing particle index table for %1%") % Hdf5FrameType::getName();
         {
-            ColTypeUInt64_5Array ctUInt64_5;
             GridController<simDim>& gc = Environment<simDim>::get().GridController();
 
             const size_t pos_offset = 2;
@@ -192,15 +195,26 @@ public:
             if (particleOffset[1] < 0) // 1 == y
                 particlesMetaInfo[pos_offset + 1] = 0;
 
-            params->dataCollector->write(
-                params->currentStep,
-                Dimensions(gc.getGlobalSize(), 1, 1),
-                Dimensions(gc.getGlobalRank(), 0, 0),
-                ctUInt64_5, 1,
-                Dimensions(1, 1, 1),
-                (std::string("particles/") + FrameType::getName() + std::string("/") +
-                    subGroup + std::string("/particles_info")).c_str(),
-                particlesMetaInfo);
+            const uint32_t currentStep = params->currentStep;
+            const uint64_t globalSize = gc.getGlobalSize();
+            const uint64_t globalRank = gc.getGlobalRank();
+            const std::string datasetName = std::string("particles/") + FrameType::getName() + std::string("/") +
+                subGroup + std::string("/particles_info");
+            std::shared_ptr<std::vector<uint64_t> > metaInfo(
+                new std::vector<uint64_t>(particlesMetaInfo, particlesMetaInfo + 5));
+
+            params->enqueue([=](ThreadParams *p)
+            {
+                ColTypeUInt64_5Array ctUInt64_5;
+                p->dataCollector->write(
+                    currentStep,
+                    Dimensions(globalSize, 1, 1),
+                    Dimensions(globalRank, 0, 0),
+                    ctUInt64_5, 1,
+                    Dimensions(1, 1, 1),
+                    datasetName.c_str(),
+                    metaInfo->data());
+            });
         }
         log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) writing particle index table for %1%") % Hdf5FrameType::getName();
 
@@ -219,19 +233,23 @@ private:
      */
     static void writeMetaAttributes(ThreadParams* params)
     {
-        typedef typename PICToSplash<float_64>::type SplashFloat64Type;
+        const uint32_t currentStep = params->currentStep;
+        const std::string groupName = std::string("particles/") + FrameType::getName();
+        const float_64 charge = (float_64)frame::getCharge<FrameType>();
+        const float_64 mass = (float_64)frame::getMass<FrameType>();
 
-        SplashFloat64Type splashType;
+        params->enqueue([=](ThreadParams *p)
+        {
+            typedef typename PICToSplash<float_64>::type SplashFloat64Type;
 
-        const std::string groupName = std::string("particles/") + FrameType::getName();
+            SplashFloat64Type splashType;
 
-        const float_64 charge = (float_64)frame::getCharge<FrameType>();
-        params->dataCollector->writeAttribute(params->currentStep,
-                splashType, groupName.c_str(), "charge", &charge);
+            p->dataCollector->writeAttribute(currentStep,
+                    splashType, groupName.c_str(), "charge", &charge);
 
-        const float_64 mass = (float_64)frame::getMass<FrameType>();
-        params->dataCollector->writeAttribute(params->currentStep,
-                splashType, groupName.c_str(), "mass", &mass);
+            p->dataCollector->writeAttribute(currentStep,
+                    splashType, groupName.c_str(), "mass", &mass);
+        });
     }
 };
 
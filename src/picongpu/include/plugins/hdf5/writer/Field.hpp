@@ -27,6 +27,9 @@
 #include "traits/GetComponentsType.hpp"
 #include "traits/GetNComponents.hpp"
 
+#include <memory>
+#include <vector>
+
 namespace picongpu
 {
 
@@ -91,58 +94,65 @@ struct Field
         splashGlobalOffsetFile[1] = std::max(0, localDomain.offset[1] -
                                              params->window.globalDimensions.offset[1]);
 
-        SplashType splashType;
-
+        const uint32_t currentStep = params->currentStep;
         size_t tmpArraySize = field_no_guard.productOfComponents();
-        ComponentType* tmpArray = new ComponentType[tmpArraySize];
 
         typedef DataBoxDim1Access<NativeDataBoxType > D1Box;
         D1Box d1Access(dataBox.shift(field_guard), field_no_guard);
 
+        Dimensions sizeSrcData(1, 1, 1);
+
+        for (uint32_t d = 0; d < simDim; ++d)
+        {
+            sizeSrcData[d] = field_no_guard[d];
+        }
+
         for (uint32_t n = 0; n < nComponents; n++)
         {
             /* copy data to temp array
              * tmpArray has the size of the data without any offsets
+             * and is owned by the write operation (can be staged)
              */
+            std::shared_ptr<std::vector<ComponentType> > tmpArray(
+                new std::vector<ComponentType>(tmpArraySize));
             for (size_t i = 0; i < tmpArraySize; ++i)
             {
-                tmpArray[i] = d1Access[i][n];
+                (*tmpArray)[i] = d1Access[i][n];
             }
 
-            std::stringstream datasetName;
-            datasetName << "fields/" << name;
+            std::stringstream datasetNameStream;
+            datasetNameStream << "fields/" << name;
             if (nComponents > 1)
-                datasetName << "/" << name_lookup.at(n);
-
-            Dimensions sizeSrcData(1, 1, 1);
+                datasetNameStream << "/" << name_lookup.at(n);
+            const std::string datasetName = datasetNameStream.str();
+            const double unitComponent = unit.at(n);
 
-            for (uint32_t d = 0; d < simDim; ++d)
+            params->enqueue([=](ThreadParams *p)
             {
-                sizeSrcData[d] = field_no_guard[d];
-            }
-
-            params->dataCollector->writeDomain(params->currentStep,             /* id == time step */
-                                               splashGlobalDomainSize,          /* total size of dataset over all processes */
-                                               splashGlobalOffsetFile,          /* write offset for this process */
-                                               splashType,                      /* data type */
-                                               simDim,                          /* NDims spatial dimensionality of the field */
-                                               splash::Selection(sizeSrcData),  /* data size of this process */
-                                               datasetName.str().c_str(),       /* data set name */
-                                               splash::Domain(
-                                                      splashGlobalDomainOffset, /* offset of the global domain */
-                                                      splashGlobalDomainSize    /* size of the global domain */
-                                               ),
-                                               DomainCollector::GridType,
-                                               tmpArray);
-
-            /*simulation attributes for data*/
-            ColTypeDouble ctDouble;
-
-            params->dataCollector->writeAttribute(params->currentStep,
-                                                  ctDouble, datasetName.str().c_str(),
-                                                  "sim_unit", &(unit.at(n)));
+                SplashType splashType;
+
+                p->dataCollector->writeDomain(currentStep,                      /* id == time step */
+                                              splashGlobalDomainSize,           /* total size of dataset over all processes */
+                                              splashGlobalOffsetFile,           /* write offset for this process */
+                                              splashType,                       /* data type */
+                                              simDim,                           /* NDims spatial dimensionality of the field */
+                                              splash::Selection(sizeSrcData),   /* data size of this process */
+                                              datasetName.c_str(),              /* data set name */
+                                              splash::Domain(
+                                                     splashGlobalDomainOffset,  /* offset of the global domain */
+                                                     splashGlobalDomainSize     /* size of the global domain */
+                                              ),
+                                              DomainCollector::GridType,
+                                              tmpArray->data());
+
+                /*simulation attributes for data*/
+                ColTypeDouble ctDouble;
+
+                p->dataCollector->writeAttribute(currentStep,
+                                                 ctDouble, datasetName.c_str(),
+                                                 "sim_unit", &unitComponent);
+            });
         }
-        __deleteArray(tmpArray);
     }
 
 };
@@ -31,6 +31,9 @@
 #include "traits/GetNComponents.hpp"
 #include "traits/Resolve.hpp"
 
+#include <memory>
+#include <vector>
+
 namespace picongpu
 {
 
@@ -75,7 +78,6 @@ struct ParticleAttribute
 
         log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) write species attribute: %1%") % Identifier::getName();
 
-        SplashType splashType;
         const std::string name_lookup[] = {"x", "y", "z"};
 
         std::vector<double> unit = Unit<T_Identifier>::get();
@@ -105,47 +107,58 @@ struct ParticleAttribute
 
         typedef typename GetComponentsType<ValueType>::type ComponentValueType;
 
-        ComponentValueType* tmpArray = new ComponentValueType[elements];
+        const uint32_t currentStep = threadParams->currentStep;
 
         for (uint32_t d = 0; d < components; d++)
         {
-            std::stringstream datasetName;
-            datasetName << subGroup << "/" << T_Identifier::getName();
+            std::stringstream datasetNameStream;
+            datasetNameStream << subGroup << "/" << T_Identifier::getName();
             if (components > 1)
-                datasetName << "/" << name_lookup[d];
+                datasetNameStream << "/" << name_lookup[d];
+            const std::string datasetName = datasetNameStream.str();
+
+            /* temp array is owned by the write operation (can be staged) */
+            std::shared_ptr<std::vector<ComponentValueType> > tmpArray(
+                new std::vector<ComponentValueType>(elements));
+            ComponentValueType* tmpPtr = tmpArray->data();
 
             ValueType* dataPtr = frame.getIdentifier(Identifier()).getPointer();
             #pragma omp parallel for
             for (size_t i = 0; i < elements; ++i)
             {
-                tmpArray[i] = ((ComponentValueType*)dataPtr)[i * components + d];
+                tmpPtr[i] = ((ComponentValueType*)dataPtr)[i * components + d];
             }
 
-            threadParams->dataCollector->writeDomain(threadParams->currentStep,
-                                                     splashType,
-                                                     1u,
-                                                     splash::Selection(Dimensions(elements, 1, 1)),
-                                                     datasetName.str().c_str(),
-                                                     splash::Domain(
-                                                            splashDomainOffset,
-                                                            splashDomainSize
-                                                     ),
-                                                     splash::Domain(
-                                                            splashGlobalDomainOffset,
-                                                            splashGlobalDomainSize
-                                                     ),
-                                                     DomainCollector::PolyType,
-                                                     tmpArray);
-
-            ColTypeDouble ctDouble;
-            if (unit.size() >= (d + 1))
-                threadParams->dataCollector->writeAttribute(threadParams->currentStep,
-                                                            ctDouble, datasetName.str().c_str(),
-                                                            "sim_unit", &(unit.at(d)));
-
+            const bool hasUnit = unit.size() >= (d + 1);
+            const double unitComponent = hasUnit ? unit.at(d) : 0.0;
 
+            params->enqueue([=](ThreadParams *p)
+            {
+                SplashType splashType;
+
+                p->dataCollector->writeDomain(currentStep,
+                                              splashType,
+                                              1u,
+                                              splash::Selection(Dimensions(elements, 1, 1)),
+                                              datasetName.c_str(),
+                                              splash::Domain(
+                                                     splashDomainOffset,
+                                                     splashDomainSize
+                                              ),
+                                              splash::Domain(
+                                                     splashGlobalDomainOffset,
+                                                     splashGlobalDomainSize
+                                              ),
+                                              DomainCollector::PolyType,
+                                              tmpArray->data());
+
+                ColTypeDouble ctDouble;
+                if (hasUnit)
+                    p->dataCollector->writeAttribute(currentStep,
+                                                     ctDouble, datasetName.c_str(),
+                                                     "sim_unit", &unitComponent);
+            });
         }
-        __deleteArray(tmpArray);
 
         log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) write species attribute: %1%") %
             Identifier::getName();
@@ -24,7 +24,6 @@
 #include "types.h"
 #include "simulation_defines.hpp"
 
-#include "mappings/kernel/AreaMapping.hpp"
 
 #include <string>
 #include <iostream>
@@ -32,11 +31,13 @@
 #include <fstream>
 
 #include "plugins/ILightweightPlugin.hpp"
+#include "plugins/particleDiagnostics/ParticleDiagnostics.hpp"
 
 #include "memory/buffers/GridBuffer.hpp"
 
 
 #include <splash/splash.h>
+#include "plugins/hdf5/SplashLock.hpp"
 #include <sys/stat.h>
 
 namespace picongpu
@@ -44,70 +45,6 @@ namespace picongpu
 using namespace PMacc;
 using namespace splash;
 
-struct CountMakroParticle
-{
-template<
-    typename T_Acc,
-    typename ParBox,
-    typename CounterBox,
-    typename Mapping>
-ALPAKA_FN_ACC void operator()(
-    T_Acc const & acc,
-    ParBox const & parBox,
-    CounterBox const & counterBox,
-    Mapping const & mapper) const
-{
-    typedef MappingDesc::SuperCellSize SuperCellSize;
-    typedef typename ParBox::FrameType FrameType;
-
-    DataSpace<simDim> const blockIndex(alpaka::idx::getIdx<alpaka::Grid, alpaka::Blocks>(acc));
-    DataSpace<simDim> const threadIndex(alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc));
-
-    const DataSpace<simDim> block(mapper.getSuperCellIndex(DataSpace<simDim > (blockIndex)));
-    /* counterBox has no guarding supercells*/
-    const DataSpace<simDim> counterCell = block - mapper.getGuardingSuperCells();
-
-    const int linearThreadIdx = DataSpaceOperations<simDim>::template map<SuperCellSize > (threadIndex);
-
-    auto counterValue(alpaka::block::shared::allocVar<uint64_cu>(acc));
-    auto frame(alpaka::block::shared::allocVar<FrameType *>(acc));
-    auto isValid(alpaka::block::shared::allocVar<bool>(acc));
-
-    if (linearThreadIdx == 0)
-    {
-        counterValue = 0;
-        frame = &(parBox.getLastFrame(block, isValid));
-        if (!isValid)
-        {
-            counterBox(counterCell) = counterValue;
-        }
-    }
-    alpaka::block::sync::syncBlockThreads(acc);
-    if (!isValid)
-        return; //end kernel if we have no frames
-
-    bool isParticle = (*frame)[linearThreadIdx][multiMask_];
-
-    while (isValid)
-    {
-        if (isParticle)
-        {
-            alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &counterValue, static_cast<uint64_cu> (1LU));
-        }
-        alpaka::block::sync::syncBlockThreads(acc);
-        if (linearThreadIdx == 0)
-        {
-            frame = &(parBox.getPreviousFrame(*frame, isValid));
-        }
-        isParticle = true;
-        alpaka::block::sync::syncBlockThreads(acc);
-    }
-
-    if (linearThreadIdx == 0)
-        counterBox(counterCell) = counterValue;
-}
-};
-
 /** Count makro particle of a species and write down the result to a global HDF5 file.
  *
  * - count the total number of makro particle per supercell
@@ -125,9 +62,7 @@ private:
 
 
     typedef MappingDesc::SuperCellSize SuperCellSize;
-    typedef GridBuffer<size_t, simDim> GridBufferType;
-
-    ParticlesType *particles;
+    typedef typename ParticleDiagnostics<ParticlesType>::SuperCellCountBuffer GridBufferType;
 
     MappingDesc *cellDescription;
     uint32_t notifyFrequency;
@@ -135,10 +70,6 @@ private:
     std::string analyzerName;
     std::string analyzerPrefix;
     std::string foldername;
-    mpi::MPIReduce reduce;
-
-    GridBufferType* localResult;
-
     ParallelDomainCollector *dataCollector;
     // set attributes for datacollector files
     DataCollector::FileCreationAttr h5_attr;
@@ -149,10 +80,8 @@ public:
     analyzerName("PerSuperCell: create hdf5 with macro particle count per superCell"),
     analyzerPrefix(ParticlesType::FrameType::getName() + std::string("_macroParticlesPerSuperCell")),
     foldername(analyzerPrefix),
-    particles(NULL),
     cellDescription(NULL),
     notifyFrequency(0),
-    localResult(NULL),
     dataCollector(NULL)
     {
         Environment<>::get().PluginConnector().registerPlugin(this);
@@ -165,11 +94,7 @@ public:
 
     void notify(uint32_t currentStep)
     {
-        DataConnector &dc = Environment<>::get().DataConnector();
-
-        particles = &(dc.getData<ParticlesType > (ParticlesType::FrameType::getName(), true));
-
-        countMakroParticles < CORE + BORDER > (currentStep);
+        countMakroParticles(currentStep);
     }
 
     void pluginRegisterHelp(po::options_description& desc)
@@ -196,10 +121,7 @@ private:
         if (notifyFrequency > 0)
         {
             Environment<>::get().PluginConnector().setNotificationPeriod(this, notifyFrequency);
-            const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
-            /* local count of supercells without any guards*/
-            DataSpace<simDim> localSuperCells(subGrid.getLocalDomain().size / SuperCellSize::toRT());
-            localResult = new GridBufferType(localSuperCells);
+            ParticleDiagnostics<ParticlesType>::getInstance().enable(particleDiagnostics::SUPERCELL_COUNT, notifyFrequency);
 
             /* create folder for hdf5 files*/
             Environment<simDim>::get().Filesystem().createDirectoryWithPermissions(foldername);
@@ -208,35 +130,26 @@ private:
 
     void pluginUnload()
     {
-        __delete(localResult);
+        if (notifyFrequency > 0)
+            ParticleDiagnostics<ParticlesType>::getInstance().disable(particleDiagnostics::SUPERCELL_COUNT);
 
+        std::lock_guard<std::mutex> lock(hdf5::splashMutex());
         if (dataCollector)
             dataCollector->finalize();
 
         __delete(dataCollector);
     }
 
-    template< uint32_t AREA>
     void countMakroParticles(uint32_t currentStep)
     {
+        /* serialize with the asynchronous HDF5 output */
+        std::lock_guard<std::mutex> lock(hdf5::splashMutex());
+
         openH5File();
 
         /*############ count particles #######################################*/
-        typedef MappingDesc::SuperCellSize SuperCellSize;
-        AreaMapping<AREA, MappingDesc> mapper(*cellDescription);
-
-        CountMakroParticle countMakroParticle;
-        __cudaKernel(
-            countMakroParticle,
-            alpaka::dim::DimInt<simDim>,
-            mapper.getGridDim(),
-            SuperCellSize::toRT())(
-                particles->getDeviceParticlesBox(),
-                localResult->getDeviceBuffer().getDataBox(), mapper);
-
-        localResult->deviceToHost();
-
-
+        /* counted in the particle sweep of all diagnostics of the species */
+        GridBufferType& localResult = ParticleDiagnostics<ParticlesType>::getInstance().getSuperCellCount(currentStep);
 
         /*############ dump data #############################################*/
         const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
@@ -261,7 +174,7 @@ private:
             localBufferSize[d] = localSize[d];
         }
 
-        size_t* ptr = localResult->getHostBuffer().getPointer();
+        size_t* ptr = localResult.getHostBuffer().getPointer();
 
         dataCollector->writeDomain(currentStep,                     /* id == time step */
                                    splashGlobalSize,                /* total size of dataset over all processes */
@@ -0,0 +1,291 @@
+/**
+ * Copyright 2013-2015 Axel Huebl, Felix Schmitt, Heiko Burau, Rene Widera,
+ *                     Richard Pausch, Benjamin Worpitz
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "types.h"
+#include "simulation_defines.hpp"
+#include "simulation_types.hpp"
+
+#include "simulation_classTypes.hpp"
+#include "memory/buffers/GridBuffer.hpp"
+#include "mappings/simulation/SubGrid.hpp"
+#include "simulationControl/MovingWindow.hpp"
+
+#include "mpi/reduceMethods/Reduce.hpp"
+#include "mpi/MPIReduce.hpp"
+#include "mpi/ReduceFuture.hpp"
+#include "nvidia/functors/Add.hpp"
+
+#include "plugins/particleDiagnostics/SglParticle.hpp"
+#include "plugins/particleDiagnostics/ParticleDiagnostics.kernel"
+
+namespace picongpu
+{
+using namespace PMacc;
+
+/** diagnostics of a species which are evaluated in one sweep over its frames
+ *
+ * Plugins enable the reducers they need (\see particleDiagnostics::Diagnostic)
+ * with their notification period in pluginLoad. The first plugin which asks
+ * for a result in a time step launches KernelParticleDiagnostics for all
+ * reducers due in this step and starts one non-blocking reduce of all sums
+ * over the MPI ranks, the other plugins read the cached results.
+ *
+ * One instance per species, \see getInstance()
+ *
+ * \tparam ParticlesType species
+ */
+template<class ParticlesType>
+class ParticleDiagnostics
+{
+public:
+    typedef floatD_X FloatPos;
+    typedef GridBuffer<size_t, simDim> SuperCellCountBuffer;
+
+    static ParticleDiagnostics&
+    getInstance()
+    {
+        static ParticleDiagnostics instance;
+        return instance;
+    }
+
+    /** evaluate a reducer every period steps
+     *
+     * Must be called by all MPI ranks.
+     */
+    void enable(const particleDiagnostics::Diagnostic diagnostic, const uint32_t period)
+    {
+        if (period == 0)
+            return;
+        periods[getSlot(diagnostic)] = period;
+        param.diagnostics |= diagnostic;
+    }
+
+    /** stop evaluating a reducer, the buffers are freed with the last reducer */
+    void disable(const particleDiagnostics::Diagnostic diagnostic)
+    {
+        periods[getSlot(diagnostic)] = 0;
+        param.diagnostics &= ~uint32_t(diagnostic);
+        if (param.diagnostics == 0u)
+            release();
+    }
+
+    /** set the parameters of the energy histogram
+     *
+     * @param numBins number of bins without the bins for < minEnergy and > maxEnergy
+     * @param minEnergy lower limit of the histogram [PIConGPU units]
+     * @param maxEnergy upper limit of the histogram [PIConGPU units]
+     * @param maximumSlopeToDetectorX,maximumSlopeToDetectorZ 0.0 is a disabled detector
+     */
+    void setEnergyHistogram(const int numBins, const float_X minEnergy, const float_X maxEnergy,
+                            const float_X maximumSlopeToDetectorX, const float_X maximumSlopeToDetectorZ)
+    {
+        param.numBins = numBins;
+        param.minEnergy = minEnergy;
+        param.maxEnergy = maxEnergy;
+        param.maximumSlopeToDetectorX = maximumSlopeToDetectorX;
+        param.maximumSlopeToDetectorZ = maximumSlopeToDetectorZ;
+    }
+
+    /** true if the reduced sums are valid on this rank */
+    bool hasReducedResult()
+    {
+        return reduce.hasResult(mpi::reduceMethods::Reduce());
+    }
+
+    /** start of the reduce of the sums of all ranks
+     *
+     * The reduce is not blocking, \see particleDiagnostics::SumIdx for the
+     * layout of the sums. The histogram weightings are normalized to
+     * TYPICAL_NUM_PARTICLES_PER_MACROPARTICLE.
+     *
+     * @param diagnostic ENERGY, COUNT or ENERGY_HISTOGRAM
+     */
+    mpi::ReduceFuture<float_64> getReducedSums(const uint32_t currentStep,
+                                               const particleDiagnostics::Diagnostic diagnostic)
+    {
+        update(currentStep, diagnostic);
+        return reducedSums;
+    }
+
+    /** number of macro particles of this rank */
+    uint64_cu getLocalCount(const uint32_t currentStep)
+    {
+        update(currentStep, particleDiagnostics::COUNT);
+        return uint64_cu(sums->getHostBuffer().getDataBox()[particleDiagnostics::COUNT_IDX]);
+    }
+
+    /** a particle of this rank, its mass is zero if the rank has no particles */
+    SglParticle<FloatPos> getPositionParticle(const uint32_t currentStep)
+    {
+        update(currentStep, particleDiagnostics::POSITION);
+        return gParticle->getHostBuffer().getDataBox()[0];
+    }
+
+    /** macro particles per local supercell (without guarding supercells) on the host */
+    SuperCellCountBuffer& getSuperCellCount(const uint32_t currentStep)
+    {
+        update(currentStep, particleDiagnostics::SUPERCELL_COUNT);
+        return *superCellCount;
+    }
+
+private:
+
+    static const uint32_t numDiagnostics = 5;
+
+    ParticleDiagnostics() :
+    sums(NULL), superCellCount(NULL), gParticle(NULL),
+    lastStep(0), lastDiagnostics(0u)
+    {
+        param.diagnostics = 0u;
+        param.numBins = 0;
+        param.minEnergy = float_X(0.0);
+        param.maxEnergy = float_X(0.0);
+        param.maximumSlopeToDetectorX = float_X(0.0);
+        param.maximumSlopeToDetectorZ = float_X(0.0);
+        for (uint32_t i = 0; i < numDiagnostics; ++i)
+            periods[i] = 0;
+    }
+
+    static uint32_t getSlot(const particleDiagnostics::Diagnostic diagnostic)
+    {
+        uint32_t slot = 0;
+        while ((1u << slot) != uint32_t(diagnostic))
+            ++slot;
+        return slot;
+    }
+
+    uint32_t getNumSums() const
+    {
+        const int realNumBins = param.isEnabled(particleDiagnostics::ENERGY_HISTOGRAM) ? param.numBins + 2 : 0;
+        return particleDiagnostics::HISTOGRAM_IDX + realNumBins;
+    }
+
+    void allocate()
+    {
+        sums = new GridBuffer<float_64, DIM1 > (DataSpace<DIM1 > (getNumSums()));
+
+        /* local count of supercells without any guards */
+        const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
+        superCellCount = new SuperCellCountBuffer(subGrid.getLocalDomain().size / MappingDesc::SuperCellSize::toRT());
+
+        gParticle = new GridBuffer<SglParticle<FloatPos>, DIM1 > (DataSpace<DIM1 > (1));
+    }
+
+    void release()
+    {
+        __delete(sums);
+        __delete(superCellCount);
+        __delete(gParticle);
+        reducedSums = mpi::ReduceFuture<float_64>();
+    }
+
+    /** evaluate all reducers due in currentStep and the requested one */
+    void update(const uint32_t currentStep, const particleDiagnostics::Diagnostic requested)
+    {
+        if (sums != NULL && lastStep == currentStep && (lastDiagnostics & requested) != 0u)
+            return;
+
+        uint32_t diagnostics = requested;
+        for (uint32_t i = 0; i < numDiagnostics; ++i)
+            if (periods[i] != 0 && currentStep % periods[i] == 0)
+                diagnostics |= 1u << i;
+
+        if (sums == NULL)
+            allocate();
+
+        DataConnector &dc = Environment<>::get().DataConnector();
+        ParticlesType* particles = &(dc.getData<ParticlesType > (ParticlesType::FrameType::getName(), true));
+
+        particleDiagnostics::Param stepParam(param);
+        stepParam.diagnostics = diagnostics;
+
+        sums->getDeviceBuffer().setValue(0.0);
+        if (stepParam.isEnabled(particleDiagnostics::SUPERCELL_COUNT))
+            superCellCount->getDeviceBuffer().setValue(0);
+        if (stepParam.isEnabled(particleDiagnostics::POSITION))
+            gParticle->getDeviceBuffer().setValue(SglParticle<FloatPos>());
+
+        /* only supercells which contain particles */
+        typename ParticlesType::ActiveSuperCellMapping mapper(particles->getActiveSuperCellMapping());
+        KernelParticleDiagnostics kernelParticleDiagnostics;
+        __cudaKernel(
+            kernelParticleDiagnostics,
+            alpaka::dim::DimInt<simDim>,
+            mapper.getGridDim(),
+            MappingDesc::SuperCellSize::toRT())(
+                particles->getDeviceParticlesBox(),
+                sums->getDeviceBuffer().getBasePointer(),
+                superCellCount->getDeviceBuffer().getDataBox(),
+                gParticle->getDeviceBuffer().getBasePointer(),
+                stepParam,
+                mapper);
+
+        sums->deviceToHost();
+        if (stepParam.isEnabled(particleDiagnostics::SUPERCELL_COUNT))
+            superCellCount->deviceToHost();
+
+        if (stepParam.isEnabled(particleDiagnostics::POSITION))
+        {
+            gParticle->deviceToHost();
+
+            const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
+            const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
+
+            DataSpace<simDim> gpuPhyCellOffset(subGrid.getLocalDomain().offset);
+            gpuPhyCellOffset.y() += (subGrid.getLocalDomain().size.y() * numSlides);
+
+            gParticle->getHostBuffer().getDataBox()[0].globalCellOffset += gpuPhyCellOffset;
+        }
+
+        /* all sums of all reducers are combined in one non-blocking message */
+        const uint32_t reducedDiagnostics = particleDiagnostics::ENERGY |
+            particleDiagnostics::COUNT |
+            particleDiagnostics::ENERGY_HISTOGRAM;
+        if (stepParam.isEnabled(reducedDiagnostics))
+        {
+            reducedSums = reduce.startReduce(nvidia::functors::Add(),
+                                             sums->getHostBuffer().getBasePointer(),
+                                             getNumSums(),
+                                             mpi::reduceMethods::Reduce());
+        }
+
+        lastStep = currentStep;
+        lastDiagnostics = diagnostics;
+    }
+
+    particleDiagnostics::Param param;
+    /* notification period of each reducer, 0 is disabled */
+    uint32_t periods[numDiagnostics];
+
+    GridBuffer<float_64, DIM1> *sums;
+    mpi::ReduceFuture<float_64> reducedSums;
+    SuperCellCountBuffer *superCellCount;
+    GridBuffer<SglParticle<FloatPos>, DIM1> *gParticle;
+
+    uint32_t lastStep;
+    uint32_t lastDiagnostics;
+
+    mpi::MPIReduce reduce;
+};
+
+} // namespace picongpu
@@ -0,0 +1,89 @@
+/**
+ * Copyright 2013-2015 Axel Huebl, Felix Schmitt, Heiko Burau, Rene Widera,
+ *                     Benjamin Worpitz
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <limits>
+
+#include "types.h"
+#include "simulation_defines.hpp"
+
+#include "dimensions/DataSpace.hpp"
+
+namespace picongpu
+{
+using namespace PMacc;
+
+/** single particle with its global cell, \see PositionsParticles */
+template<class FloatPos>
+struct SglParticle
+{
+    FloatPos position;
+    float3_X momentum;
+    float_X mass;
+    float_X weighting;
+    float_X charge;
+    float_X gamma;
+
+    SglParticle() : position(FloatPos::create(0.0)), momentum(float3_X::create(0.0)), mass(0.0),
+        weighting(0.0), charge(0.0), gamma(0.0)
+    {
+    }
+
+    DataSpace<simDim> globalCellOffset;
+
+    //! todo
+
+    floatD_64 getGlobalCell() const
+    {
+        floatD_64 doubleGlobalCellOffset;
+        for(uint32_t i=0;i<simDim;++i)
+            doubleGlobalCellOffset[i]=float_64(globalCellOffset[i]);
+
+        return floatD_64( doubleGlobalCellOffset+ precisionCast<float_64>(position));
+    }
+
+    template<typename T>
+        friend std::ostream& operator<<(std::ostream& out, const SglParticle<T>& v)
+    {
+        floatD_64 pos;
+        for(uint32_t i=0;i<simDim;++i)
+            pos[i]=( v.getGlobalCell()[i] * cellSize[i]*UNIT_LENGTH);
+
+        const float3_64 mom( precisionCast<float_64>(v.momentum.x()) * UNIT_MASS * UNIT_SPEED,
+                             precisionCast<float_64>(v.momentum.y()) * UNIT_MASS * UNIT_SPEED,
+                             precisionCast<float_64>(v.momentum.z()) * UNIT_MASS * UNIT_SPEED );
+
+        const float_64 mass = precisionCast<float_64>(v.mass) * UNIT_MASS;
+        const float_64 charge = precisionCast<float_64>(v.charge) * UNIT_CHARGE;
+
+        typedef std::numeric_limits< float_64 > dbl;
+        out.precision(dbl::digits10);
+
+        out << std::scientific << pos << " " << mom << " " << mass << " "
+            << precisionCast<float_64>(v.weighting)
+            << " " << charge << " " << precisionCast<float_64>(v.gamma);
+        return out;
+    }
+};
+
+} /* namespace picongpu */
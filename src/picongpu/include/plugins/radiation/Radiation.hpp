@@ -51,6 +51,7 @@
 
 /* libSpash data output */
 #include <splash/splash.h>
+#include "plugins/hdf5/SplashLock.hpp"
 #include <boost/filesystem.hpp>
 
 namespace picongpu
@@ -530,6 +531,8 @@ private:
    */
   void writeHDF5file(Amplitude* values, std::string name)
   {
+      /* serialize with the asynchronous HDF5 output */
+      std::lock_guard<std::mutex> lock(hdf5::splashMutex());
       splash::SerialDataCollector HDF5dataFile(1);
       splash::DataCollector::FileCreationAttr fAttr;
 
@@ -603,6 +606,7 @@ private:
    */
   void readHDF5file(Amplitude* values, std::string name, const int timeStep)
   {
+      std::lock_guard<std::mutex> lock(hdf5::splashMutex());
       splash::SerialDataCollector HDF5dataFile(1);
       splash::DataCollector::FileCreationAttr fAttr;
 
@@ -750,6 +754,23 @@ private:
       DataSpace<simDim> globalOffset(subGrid.getLocalDomain().offset);
       globalOffset.y() += (localSize.y() * numSlides);
 
+#ifdef PMACC_ACC_CPU
+      /* on CPU a block computes a tile of observers x frequencies */
+      const DataSpace<simDim> gridDimTiled_rad(KernelRadiationParticlesTiled::numObserverTiles *
+                                               KernelRadiationParticlesTiled::numOmegaTiles);
+      KernelRadiationParticlesTiled kernelRadiationParticles;
+      __cudaKernel(
+            kernelRadiationParticles,
+            alpaka::dim::DimInt<simDim>,
+            gridDimTiled_rad,
+            blockDim_rad)(
+                particles->getDeviceParticlesBox(),
+                radiation->getDeviceBuffer().getDataBox(),
+                globalOffset,
+                currentStep, *cellDescription,
+                freqFkt,
+                subGrid.getGlobalDomain().size);
+#else
       KernelRadiationParticles kernelRadiationParticles;
       // PIC-like kernel call of the radiation kernel
       __cudaKernel(
@@ -766,6 +787,7 @@ private:
                 currentStep, *cellDescription,
                 freqFkt,
                 subGrid.getGlobalDomain().size);
+#endif
 
       if (dumpPeriod != 0 && currentStep % dumpPeriod == 0)
       {
@@ -25,6 +25,7 @@
 #include <cassert>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 
 #include "types.h"
@@ -44,8 +45,10 @@
 #include "fields/FieldB.hpp"
 #include "fields/FieldJ.hpp"
 #include "fields/FieldTmp.hpp"
+#include "fields/EMFCommunication.hpp"
 #include "particles/MallocMCBuffer.hpp"
 #include "fields/MaxwellSolver/Solvers.hpp"
+#include "traits/UsesFieldBackBuffer.hpp"
 #include "fields/currentInterpolation/CurrentInterpolation.hpp"
 #include "fields/background/cellwiseOperation.hpp"
 #include "initialization/IInitPlugin.hpp"
@@ -86,6 +89,7 @@ public:
     MySimulation() :
     fieldB(NULL),
     fieldE(NULL),
+    emfCommunication(NULL),
     fieldJ(NULL),
     fieldTmp(NULL),
     mallocMCBuffer(NULL),
@@ -93,10 +97,13 @@ public:
     myCurrentInterpolation(NULL),
     pushBGField(NULL),
     currentBGField(NULL),
+    backgroundStorageE(NULL),
+    backgroundStorageB(NULL),
     laser(NULL),
     initialiserController(NULL),
     cellDescription(NULL),
-    slidingWindow(false)
+    slidingWindow(false),
+    neighborCollectives(false)
     {
         ForEach<VectorAllSpecies, particles::AssignNull<bmpl::_1>, MakeIdentifier<bmpl::_1> > setPtrToNull;
         setPtrToNull(forward(particleStorage));
@@ -122,7 +129,10 @@ public:
             ("periodic", po::value<std::vector<uint32_t> > (&periodic)->multitoken(),
              "specifying whether the grid is periodic (1) or not (0) in each dimension, default: no periodic dimensions")
 
-            ("moving,m", po::value<bool>(&slidingWindow)->zero_tokens(), "enable sliding/moving window");
+            ("moving,m", po::value<bool>(&slidingWindow)->zero_tokens(), "enable sliding/moving window")
+
+            ("mpi.neighborCollectives", po::value<bool>(&neighborCollectives)->zero_tokens(),
+             "exchange guards and particles with MPI-3 neighborhood collectives instead of point-to-point messages");
     }
 
     std::string pluginGetName() const
@@ -171,6 +181,8 @@ public:
         }
 
         Environment<simDim>::get().initDevices(gpus, isPeriodic);
+        if (neighborCollectives)
+            Environment<simDim>::get().GridController().useNeighborCollectives();
 
         DataSpace<simDim> myGPUpos(Environment<simDim>::get().GridController().getPosition());
 
@@ -236,6 +248,9 @@ public:
     {
 
         SimulationHelper<simDim>::pluginUnload();
+        /* references the fields, must be deleted first */
+        __delete(emfCommunication);
+
         __delete(fieldB);
 
         __delete(fieldE);
@@ -254,6 +269,8 @@ public:
         deleteParticleMemory(forward(particleStorage));
 
         __delete(laser);
+        __delete(backgroundStorageE);
+        __delete(backgroundStorageB);
         __delete(pushBGField);
         __delete(currentBGField);
         __delete(cellDescription);
@@ -277,9 +294,22 @@ public:
 
         laser = new LaserPhysics(cellDescription->getGridLayout());
 
+        /* allocated before the particle heap takes the free memory */
+        backgroundStorageE = cellwiseOperation::createBackgroundStorage(FieldBackgroundE(fieldE->getUnit()));
+        backgroundStorageB = cellwiseOperation::createBackgroundStorage(FieldBackgroundB(fieldB->getUnit()));
+
         ForEach<VectorAllSpecies, particles::CreateSpecies<bmpl::_1>, MakeIdentifier<bmpl::_1> > createSpeciesMemory;
         createSpeciesMemory(forward(particleStorage), cellDescription);
 
+        /* the back buffers of an out of place field solver are allocated
+         * with E and B above and are therefore not given to the heap */
+        if( picongpu::traits::UsesFieldBackBuffer<fieldSolver::FieldSolver>::value )
+        {
+            const size_t backBufferMem = cellDescription->getGridLayout().getDataSpace().productOfComponents() *
+                ( sizeof(FieldE::ValueType) + sizeof(FieldB::ValueType) );
+            log<picLog::MEMORY > ("field solver back buffers of E and B use %1% MiB") % (backBufferMem / 1024 / 1024);
+        }
+
         size_t freeGpuMem(0);
         Environment<>::get().EnvMemoryInfo().setReservedMemory(totalFreeGpuMemory);
         Environment<>::get().EnvMemoryInfo().getMemoryInfo(&freeGpuMem);
@@ -292,6 +322,14 @@ public:
         else
             log<picLog::MEMORY > ("RAM is NOT shared between GPU and host.");
 
+        /* hold back the memory adaptive particle exchanges can grow by */
+        if( EXCHANGE_ADAPT_PERIOD != 0 )
+        {
+            const size_t exchangeGrowth = bmpl::size<VectorAllSpecies>::type::value * size_t(BYTES_EXCHANGE_GROWTH);
+            freeGpuMem -= std::min(freeGpuMem, exchangeGrowth);
+            log<picLog::MEMORY > ("hold back %1% MiB for growing particle exchanges") % (exchangeGrowth / 1024 / 1024);
+        }
+
         // initializing the heap for particles
         mallocMC::initHeap(freeGpuMem);
         this->mallocMCBuffer = new MallocMCBuffer();
@@ -307,6 +345,8 @@ public:
         fieldJ->init(*fieldE, *fieldB);
         fieldTmp->init();
 
+        emfCommunication = new EMFCommunication(*fieldE, *fieldB);
+
         // create field solver
         this->myFieldSolver = new fieldSolver::FieldSolver(*cellDescription);
 
@@ -317,6 +357,8 @@ public:
         ForEach<VectorAllSpecies, particles::CallInit<bmpl::_1>, MakeIdentifier<bmpl::_1> > particleInit;
         particleInit(forward(particleStorage), fieldE, fieldB, fieldJ, fieldTmp);
 
+        /* all exchanges of fields and particles exist, nothing was sent yet */
+        Environment<simDim>::get().EnvironmentController().getCommunicator().finishExchangeRegistration();
 
         /* add CUDA streams to the StreamController for concurrent execution */
         Environment<>::get().StreamController().addStreams(6);
@@ -340,6 +382,7 @@ public:
                     }
                 }
 
+                /* the restart removes the background from E and B if the file contains it */
                 initialiserController->restart((uint32_t)this->restartStep, this->restartDirectory);
                 step = this->restartStep + 1;
             }
@@ -354,24 +397,9 @@ public:
         Environment<>::get().EnvMemoryInfo().getMemoryInfo(&freeGpuMem);
         log<picLog::MEMORY > ("free mem after all particles are initialized %1% MiB") % (freeGpuMem / 1024 / 1024);
 
-        /** a background field for the particle pusher might be added at the
-            beginning of a simulation in movingWindowCheck()
-            At restarts the external fields are already added and will be
-            double-counted, so we remove it in advance. */
-        if( step != 0 )
-        {
-            namespace nvfct = PMacc::nvidia::functors;
-            (*pushBGField)( fieldE, nvfct::Sub(), FieldBackgroundE(fieldE->getUnit()),
-                            step, FieldBackgroundE::InfluenceParticlePusher);
-            (*pushBGField)( fieldB, nvfct::Sub(), FieldBackgroundB(fieldB->getUnit()),
-                            step, FieldBackgroundB::InfluenceParticlePusher);
-        }
-
         // communicate all fields
-        EventTask eRfieldE = fieldE->asyncCommunication(__getTransactionEvent());
-        __setTransactionEvent(eRfieldE);
-        EventTask eRfieldB = fieldB->asyncCommunication(__getTransactionEvent());
-        __setTransactionEvent(eRfieldB);
+        EventTask eRfields = emfCommunication->asyncCommunication(__getTransactionEvent());
+        __setTransactionEvent(eRfields);
 
         return step;
     }
@@ -390,12 +418,27 @@ public:
     {
         namespace nvfct = PMacc::nvidia::functors;
 
+        /* resize particle exchange buffers to the traffic of the last steps */
+        if (EXCHANGE_ADAPT_PERIOD != 0 && currentStep != 0 && currentStep % EXCHANGE_ADAPT_PERIOD == 0)
+        {
+            ForEach<VectorAllSpecies, particles::CallAdaptExchangeBuffers<bmpl::_1>, MakeIdentifier<bmpl::_1> > adaptExchangeBuffers;
+            adaptExchangeBuffers(forward(particleStorage));
+        }
+
         /* Initialize ionization routine for each species
          *      - valid species will be ionized
          *      - invalid species (e.g. electrons): fallback */
         ForEach<VectorAllSpecies, particles::CallIonization<bmpl::_1>, MakeIdentifier<bmpl::_1> > particleIonization;
         particleIonization(forward(particleStorage), cellDescription, currentStep);
 
+        /* the current is deposited during the push if ENABLE_FUSED_CURRENT is set,
+         * a background current is the start value instead of zero */
+        if( FieldBackgroundJ::activated )
+            (*currentBGField)(fieldJ, nvfct::Assign(), FieldBackgroundJ(fieldJ->getUnit()),
+                              currentStep);
+        else
+            fieldJ->clear();
+
         EventTask initEvent = __getTransactionEvent();
         EventTask updateEvent;
         EventTask commEvent;
@@ -404,19 +447,11 @@ public:
         particleUpdate(forward(particleStorage), currentStep, initEvent, forward(updateEvent), forward(commEvent));
 
         __setTransactionEvent(updateEvent);
-        /** remove background field for particle pusher */
-        (*pushBGField)(fieldE, nvfct::Sub(), FieldBackgroundE(fieldE->getUnit()),
-                       currentStep, FieldBackgroundE::InfluenceParticlePusher);
-        (*pushBGField)(fieldB, nvfct::Sub(), FieldBackgroundB(fieldB->getUnit()),
-                       currentStep, FieldBackgroundB::InfluenceParticlePusher);
-
+        /* background fields for the particle pusher are added on the fly
+         * while the pusher caches E and B */
         this->myFieldSolver->update_beforeCurrent(currentStep);
 
-        fieldJ->clear();
-
         __setTransactionEvent(commEvent);
-        (*currentBGField)(fieldJ, nvfct::Add(), FieldBackgroundJ(fieldJ->getUnit()),
-                          currentStep, FieldBackgroundJ::activated);
 #if (ENABLE_CURRENT == 1)
         ForEach<VectorAllSpecies, ComputeCurrent<bmpl::_1,bmpl::int_<CORE + BORDER> >, MakeIdentifier<bmpl::_1> > computeCurrent;
         computeCurrent(forward(fieldJ),forward(particleStorage), currentStep);
@@ -462,19 +497,39 @@ public:
         {
             slide(currentStep);
         }
+    }
 
-        /** add background field: the movingWindowCheck is just at the start
-         * of a time step before all the plugins are called (and the step
-         * itself is performed for this time step).
-         * Hence the background field is visible for all plugins
-         * in between the time steps.
-         */
+    /** background fields for the particle pusher are visible for all plugins
+     *
+     * They are only added to E and B in steps where a plugin is notified and
+     * removed before a checkpoint is written.
+     * Checkpoint format: files mark with the attribute
+     * fieldBackground::containedAttributeName if E and B contain the
+     * background, files of older versions without the attribute are restarted
+     * by removing it, \see fields/background/CheckpointBackground.hpp
+     */
+    virtual void notifyPlugins(uint32_t currentStep)
+    {
         namespace nvfct = PMacc::nvidia::functors;
 
-        (*pushBGField)( fieldE, nvfct::Add(), FieldBackgroundE(fieldE->getUnit()),
-                        currentStep, FieldBackgroundE::InfluenceParticlePusher );
-        (*pushBGField)( fieldB, nvfct::Add(), FieldBackgroundB(fieldB->getUnit()),
-                        currentStep, FieldBackgroundB::InfluenceParticlePusher );
+        const bool addBackground = Environment<>::get().PluginConnector().hasNotifications(currentStep);
+        if( addBackground )
+        {
+            (*pushBGField)( fieldE, nvfct::Add(), FieldBackgroundE(fieldE->getUnit()),
+                            currentStep, FieldBackgroundE::InfluenceParticlePusher );
+            (*pushBGField)( fieldB, nvfct::Add(), FieldBackgroundB(fieldB->getUnit()),
+                            currentStep, FieldBackgroundB::InfluenceParticlePusher );
+        }
+
+        SimulationHelper<simDim>::notifyPlugins(currentStep);
+
+        if( addBackground )
+        {
+            (*pushBGField)( fieldE, nvfct::Sub(), FieldBackgroundE(fieldE->getUnit()),
+                            currentStep, FieldBackgroundE::InfluenceParticlePusher );
+            (*pushBGField)( fieldB, nvfct::Sub(), FieldBackgroundB(fieldB->getUnit()),
+                            currentStep, FieldBackgroundB::InfluenceParticlePusher );
+        }
     }
 
     void resetAll(uint32_t currentStep)
@@ -581,6 +636,7 @@ protected:
     // fields
     FieldB *fieldB;
     FieldE *fieldE;
+    EMFCommunication *emfCommunication;
     FieldJ *fieldJ;
     FieldTmp *fieldTmp;
     MallocMCBuffer *mallocMCBuffer;
@@ -591,6 +647,9 @@ protected:
 
     cellwiseOperation::CellwiseOperation< CORE + BORDER + GUARD >* pushBGField;
     cellwiseOperation::CellwiseOperation< CORE + BORDER + GUARD >* currentBGField;
+    /* device memory of the background fields, e.g. tabulated TWTS fields */
+    cellwiseOperation::IBackgroundStorage* backgroundStorageE;
+    cellwiseOperation::IBackgroundStorage* backgroundStorageB;
 
     typedef SeqToMap<VectorAllSpecies, TypeToPointerPair<bmpl::_1> >::type ParticleStorageMap;
     typedef PMacc::math::MapTuple<ParticleStorageMap> ParticleStorage;
@@ -617,6 +676,7 @@ protected:
     std::vector<std::string> gridDistribution;
 
     bool slidingWindow;
+    bool neighborCollectives;
 };
 } /* namespace picongpu */
 
@@ -27,6 +27,7 @@
 #include "mappings/kernel/AreaMapping.hpp"
 #include "math/Vector.hpp"
 #include "eventSystem/EventSystem.hpp"
+#include "eventSystem/events/kernelEvents.hpp"
 #include "types.h"
 
 #include <boost/predef.h>
@@ -69,8 +70,59 @@ namespace picongpu
  */
 #define __picKernelArea(KERNEL, DIM, description, area, block)\
     {\
-        PMACC_KERNEL_CATCH(::alpaka::wait::wait(::PMacc::Environment<>::get().DeviceManager().getAccDevice()), "picKernelArea: crash before kernel call");\
+        PMACC_KERNEL_CATCH(::PMacc::Environment<>::get().StreamController().waitForAll(), "picKernelArea: crash before kernel call");\
         ::PMacc::AreaMapping<area, MappingDesc> mapper(description);\
         ::PMacc::TaskKernel * const taskKernel(::PMacc::Environment<>::get().Factory().createTaskKernel(#KERNEL));\
         auto const exec(::alpaka::exec::create<::PMacc::AlpakaAcc<DIM>>(::alpaka::workdiv::WorkDivMembers<DIM, AlpakaIdxSize>(mapper.getGridDim(),block,static_cast<AlpakaIdxSize>(1u)), KERNEL\
         PIC_KERNEL_PARAMS
+
+/**
+ * Calls a kernel written for the element layer (see PMACC_KERNEL_ELEMENT_LAYER)
+ * and creates an EventTask which represents the kernel.
+ *
+ * gridsize for kernel call is set by mapper
+ * last argument of kernel call is add by mapper and is the mapper
+ *
+ * @param kernelname name of the kernel (can also used with templates etc. myKernnel<1>)
+ * @param area area type for which the kernel is called
+ */
+#define __picKernelAreaElements(KERNEL, DIM, description, area, block)\
+    {\
+        PMACC_KERNEL_CATCH(::PMacc::Environment<>::get().StreamController().waitForAll(), "picKernelAreaElements: crash before kernel call");\
+        ::PMacc::AreaMapping<area, MappingDesc> mapper(description);\
+        ::PMacc::TaskKernel * const taskKernel(::PMacc::Environment<>::get().Factory().createTaskKernel(#KERNEL));\
+        auto const exec(::alpaka::exec::create<::PMacc::AlpakaAccElements<DIM>>(::PMacc::getWorkDivElements<DIM>(mapper.getGridDim(),block), KERNEL\
+        PIC_KERNEL_PARAMS
+
+/**
+ * Calls a kernel with a given mapper (e.g. the active supercell mapping of a
+ * species) and creates an EventTask which represents the kernel.
+ *
+ * gridsize for kernel call is set by mapper
+ * last argument of kernel call is add by mapper and is the mapper
+ *
+ * @param kernelname name of the kernel (can also used with templates etc. myKernnel<1>)
+ * @param mapperInstance mapper (copied, must not be named `mapper`)
+ */
+#define __picKernelMapper(KERNEL, DIM, mapperInstance, block)\
+    {\
+        PMACC_KERNEL_CATCH(::PMacc::Environment<>::get().StreamController().waitForAll(), "picKernelMapper: crash before kernel call");\
+        auto const mapper(mapperInstance);\
+        ::PMacc::TaskKernel * const taskKernel(::PMacc::Environment<>::get().Factory().createTaskKernel(#KERNEL));\
+        auto const exec(::alpaka::exec::create<::PMacc::AlpakaAcc<DIM>>(::alpaka::workdiv::WorkDivMembers<DIM, AlpakaIdxSize>(mapper.getGridDim(),block,static_cast<AlpakaIdxSize>(1u)), KERNEL\
+        PIC_KERNEL_PARAMS
+
+/**
+ * Calls a kernel written for the element layer (see PMACC_KERNEL_ELEMENT_LAYER)
+ * with a given mapper and creates an EventTask which represents the kernel.
+ *
+ * @param kernelname name of the kernel (can also used with templates etc. myKernnel<1>)
+ * @param mapperInstance mapper (copied, must not be named `mapper`)
+ */
+#define __picKernelMapperElements(KERNEL, DIM, mapperInstance, block)\
+    {\
+        PMACC_KERNEL_CATCH(::PMacc::Environment<>::get().StreamController().waitForAll(), "picKernelMapperElements: crash before kernel call");\
+        auto const mapper(mapperInstance);\
+        ::PMacc::TaskKernel * const taskKernel(::PMacc::Environment<>::get().Factory().createTaskKernel(#KERNEL));\
+        auto const exec(::alpaka::exec::create<::PMacc::AlpakaAccElements<DIM>>(::PMacc::getWorkDivElements<DIM>(mapper.getGridDim(),block), KERNEL\
+        PIC_KERNEL_PARAMS
@@ -46,6 +46,9 @@ enum CommunicationTag
     FIELD_J = 3u,
     FIELD_JRECV = 4u,
     FIELD_TMP = 5u,
+    FIELD_E_BACK = 6u,
+    FIELD_B_BACK = 7u,
+    FIELD_EB = 8u,
     SPECIES_FIRSTTAG = 42u
 };
 
@@ -0,0 +1,45 @@
+/**
+ * Copyright 2013-2015 Rene Widera
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace picongpu
+{
+
+namespace traits
+{
+/** check if the halos of E and B are sent in one message per neighbor
+ *
+ * If true, the guards of FieldE and FieldB are exchanged with one
+ * PMacc::CommunicationGroup (one message per neighbor instead of two)
+ * wherever both fields are communicated at the same time.
+ * The default is true, set it to false to communicate each field on its own.
+ *
+ * \tparam Solver field solver type
+ */
+template<class Solver>
+struct AggregateFieldHalos
+{
+    static const bool value = true;
+};
+
+} //namespace traits
+
+}// namespace picongpu
@@ -0,0 +1,44 @@
+/**
+ * Copyright 2026 agent
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace picongpu
+{
+
+namespace traits
+{
+/** check if a field solver writes out of place into a second field buffer
+ *
+ * If true, FieldE and FieldB allocate a back buffer (with own exchanges)
+ * which can be filled by the solver and swapped with the front buffer.
+ * The default is false (solver updates the fields in place).
+ *
+ * \tparam Solver field solver type
+ */
+template<class Solver>
+struct UsesFieldBackBuffer
+{
+    static const bool value = false;
+};
+
+} //namespace traits
+
+}// namespace picongpu
@@ -85,6 +85,7 @@ MALLOCMC_SET_ALLOCATOR_TYPE( AllocatorHostNew );
 
 #include <simulation_defines.hpp>
 #include <mpi.h>
+#include <string>
 
 
 using namespace PMacc;
@@ -97,9 +98,17 @@ using namespace picongpu;
  */
 int main(int argc, char **argv)
 {
+    /* MPI_THREAD_MULTIPLE is only needed by asynchronous plugin output,
+     * plugins check the provided level with MPI_Query_thread */
+    int required = MPI_THREAD_FUNNELED;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--hdf5.async")
+            required = MPI_THREAD_MULTIPLE;
+    }
+
     int prov;
-    MPI_CHECK(MPI_Init_thread(&argc, &argv,MPI_THREAD_FUNNELED,&prov));
-    std::cout<<"openmpi "<<prov<<"=="<<MPI_THREAD_FUNNELED<<std::endl;
+    MPI_CHECK(MPI_Init_thread(&argc, &argv, required, &prov));
 
 
     picongpu::simulation_starter::SimStarter sim;